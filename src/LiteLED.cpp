@@ -34,6 +34,10 @@ LiteLED::LiteLED( led_strip_type_t led_type, bool rgbw ) {
     theStrip.bright_act = 255;
     theStrip.buf = NULL;
     theStrip.use_psram = false;  // Default to internal RAM
+    theStrip.dirty_lo = 0;
+    theStrip.dirty_hi = 0;
+    theStrip.stripCfg.done_cb = NULL;   // onShowDone() may set it before begin(), which keeps it
+    theStrip.stripCfg.done_arg = NULL;
     valid_instance = false;      // Not valid until begin() succeeds
 }
 
@@ -80,7 +84,7 @@ esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, bool auto_w ) {
     res = led_strip_install( &theStrip );
     if ( res != ESP_OK ) {
         log_d( "Failed to install strip. Result = %s", esp_err_to_name( res ) );
-        return res;
+        return res;     // led_strip_install() has already released what it allocated
     }
 
     // Register channel -> instance mapping BEFORE registering with Peripheral Manager
@@ -157,7 +161,7 @@ esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, ll_psram_t psram_flag
     res = led_strip_install( &theStrip );
     if ( res != ESP_OK ) {
         log_d( "Failed to install strip. Result = %s", esp_err_to_name( res ) );
-        return res;
+        return res;     // led_strip_install() has already released what it allocated
     }
 
     // Register channel -> instance mapping BEFORE registering with Peripheral Manager
@@ -185,6 +189,10 @@ esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, ll_psram_t psram_flag
 }
 
 esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, ll_dma_t dma_flag, ll_priority_t priority, ll_psram_t psram_flag, bool auto_w ) {
+    return LiteLED::begin( data_pin, length, dma_flag, priority, psram_flag, ENCODER_DEFAULT, auto_w );
+}
+
+esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, ll_dma_t dma_flag, ll_priority_t priority, ll_psram_t psram_flag, ll_encoder_t enc_flag, bool auto_w ) {
     /* add the data pin & length to the structure */
     ll_log_capabilities();  // Log hardware capabilities once
 
@@ -235,10 +243,15 @@ esp_err_t LiteLED::begin( uint8_t data_pin, size_t length, ll_dma_t dma_flag, ll
         log_d( "Failed to set strip DMA or interrupt priority. Result = %s", esp_err_to_name( res ) );
         return res;
     }
+    res = led_strip_init_encoder( &theStrip, enc_flag );
+    if ( res != ESP_OK ) {
+        log_d( "Failed to set strip led encoder. Result = %s", esp_err_to_name( res ) );
+        return res;
+    }
     res = led_strip_install( &theStrip );
     if ( res != ESP_OK ) {
         log_d( "Failed to install strip. Result = %s", esp_err_to_name( res ) );
-        return res;
+        return res;     // led_strip_install() has already released what it allocated
     }
 
     // Register channel -> instance mapping BEFORE registering with Peripheral Manager
@@ -281,6 +294,58 @@ esp_err_t LiteLED::show() {
     return _res;
 }
 
+esp_err_t LiteLED::showAsync() {
+    if ( !isValid() ) {
+        log_d( "LiteLED: Instance is no longer valid (pin may have been reassigned)" );
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t _res = led_strip_flush_async( &theStrip );
+    if ( _res != ESP_OK ) {
+        log_d( "Error in 'showAsync()'. Cannot flush strip. Result = %s", esp_err_to_name( _res ) );
+        return _res;
+    }
+    theStrip.bright_act = theStrip.brightness;
+    return _res;
+}
+
+bool LiteLED::isBusy() const {
+    return ( theStrip.stripCfg.tx_busy != 0 );
+}
+
+esp_err_t LiteLED::waitShow( int32_t timeout_ms ) {
+    if ( !isValid() ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return led_strip_wait( &theStrip, timeout_ms );
+}
+
+void LiteLED::onShowDone( ll_show_done_cb_t callback, void *arg ) {
+    // Clear the callback first so the ISR never sees a new callback paired with the old argument
+    theStrip.stripCfg.done_cb = NULL;
+    theStrip.stripCfg.done_arg = arg;
+    theStrip.stripCfg.done_cb = callback;
+}
+
+esp_err_t LiteLED::hold( uint32_t refresh_ms ) {
+    if ( !isValid() ) {
+        log_d( "LiteLED: Instance is no longer valid (pin may have been reassigned)" );
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t _res = led_strip_hold( &theStrip, refresh_ms );
+    if ( _res != ESP_OK ) {
+        log_d( "Error in 'hold()'. Cannot hold strip. Result = %s", esp_err_to_name( _res ) );
+        return _res;
+    }
+    theStrip.bright_act = theStrip.brightness;
+    return _res;
+}
+
+bool LiteLED::isHolding() const {
+    return ( theStrip.stripCfg.hold_mode != LL_HOLD_NONE );
+}
+
 esp_err_t LiteLED::setPixel( size_t num, rgb_t color, bool show ) {
     esp_err_t _res = ll_checkPinState();
     if ( _res != ESP_OK ) {
@@ -441,6 +506,13 @@ bool LiteLED::isValid() const {
     return ( theStrip.buf != NULL && theStrip.stripCfg.led_chan != NULL );
 }
 
+size_t LiteLED::getRefillInterrupts() {
+    if ( !isValid() ) {
+        return 0;
+    }
+    return led_strip_refill_irqs( &theStrip );
+}
+
 bool LiteLED::isGpioAvailable( uint8_t gpio_pin ) {
     if ( !perimanPinIsValid( gpio_pin ) ) {
         return false;
@@ -55,8 +55,10 @@ static_assert( ESP_ARDUINO_VERSION >= ESP_ARDUINO_VERSION_VAL( 3, 0, 0 ),
 #endif
 
 #include "driver/rmt_tx.h"
+#include "esp_timer.h"
 #if SOC_PARLIO_SUPPORTED
     #include "driver/parlio_tx.h"
+    #include "freertos/semphr.h"
 #endif
 #include "llrgb.h"
 
@@ -92,6 +94,18 @@ enum color_order_t {
     ORDER_MAX   // not a valid colour order, used to mark the end of the enum
 };
 
+// defines for selecting the RMT led encoder
+enum ll_encoder_t : uint32_t {
+    ENCODER_BYTE = 0,       // Encode one LED data byte per encoder callback
+    ENCODER_BATCH = 1,      // Encode as many LED data bytes as fit in the free RMT symbol space per callback
+    ENCODER_STAGED = 2,     // Stage brightness-scaled data at show() time and encode with the IDF bytes + copy encoders
+    ENCODER_FRAME = 3,      // Encode the whole frame to RMT symbols at show() time and stream it with the IDF copy encoder (RMT DMA chips only)
+    ENCODER_DEFAULT = ENCODER_BATCH
+};
+
+// user callback run when a show() or showAsync() frame has been sent. Called from the RMT / PARLIO TX done ISR
+typedef void ( *ll_show_done_cb_t )( void *arg );
+
 typedef struct {
     rmt_tx_channel_config_t     led_chan_config;    /* RMT channel configuration for the LED strip. */
     rmt_transmit_config_t       led_tx_config;      /* RMT transmit configuration */
@@ -99,6 +113,19 @@ typedef struct {
     rmt_simple_encoder_config_t led_encoder_cfg;    /* RMT encoder configuration */
     rmt_encoder_handle_t        led_encoder = NULL; /* RMT encoder handle */
     size_t                      enc_pos;            /* position in the LED data buffer */
+    ll_encoder_t                enc_mode;           /* RMT encoder selection */
+    const rmt_symbol_word_t    *sym_lut;            /* byte-to-symbol lookup table (256 x 8 symbols, shared per LED type) */
+    uint8_t                    *enc_buf;            /* brightness-scaled staging buffer (ENCODER_STAGED only) */
+    rmt_symbol_word_t          *frame_buf;          /* pre-encoded frame including reset (ENCODER_FRAME only) */
+    size_t                      frame_symbols;      /* number of symbols in frame_buf */
+    rmt_encoder_handle_t        hold_encoder;       /* copy encoder used by hold() when not in ENCODER_FRAME mode */
+    esp_timer_handle_t          hold_timer;         /* periodic refresh timer used by hold() when a hardware loop is not possible */
+    volatile uint8_t            hold_mode;          /* LL_HOLD_NONE, LL_HOLD_LOOP or LL_HOLD_TIMER */
+    volatile uint8_t            hold_refreshing;    /* set while the hold timer callback is queueing a repeat */
+    rmt_symbol_word_t           reset_sym;          /* DRAM copy of the LED type's reset symbol, read by the encoder ISR */
+    volatile uint8_t            tx_busy;            /* set while a show() frame is on the wire, cleared by the TX done ISR */
+    volatile ll_show_done_cb_t  done_cb;            /* optional user callback run from the TX done ISR */
+    void              *volatile done_arg;           /* argument passed to done_cb */
 } led_strip_cfg_t;
 
 typedef struct {
@@ -108,12 +135,47 @@ typedef struct {
     color_order_t order;
 } led_params_t;
 
+// Most PARLIO samples per LED bit the timing synthesizer in ll_led_timings.h
+// may choose.  Sizes the nibble tables below.
+#define PARLIO_MAX_SAMPLES_PER_BIT 4
+
+// PARLIO TX units on this chip: the most LiteLEDpioGroup instances that can
+// run at once, and so the most LiteLEDpioGroup::showAll() can send.
+#if defined( SOC_PARLIO_GROUPS ) && defined( SOC_PARLIO_TX_UNITS_PER_GROUP )
+    #define LL_PARLIO_TX_UNITS  ( SOC_PARLIO_GROUPS * SOC_PARLIO_TX_UNITS_PER_GROUP )
+#else
+    #define LL_PARLIO_TX_UNITS  1
+#endif
+
+// PARLIO transfer completion state (used by LiteLEDpio and LiteLEDpioGroup).
+// Passed to the TX unit's done callback.
+#if SOC_PARLIO_SUPPORTED
+typedef struct {
+    SemaphoreHandle_t           stream_sem;       /* streaming: counts finished chunk transfers */
+    volatile uint8_t            tx_busy;          /* set while a frame is on the wire, cleared by the TX done ISR */
+    volatile ll_show_done_cb_t  done_cb;          /* optional user callback run when a frame has been sent */
+    void              *volatile done_arg;         /* argument passed to done_cb */
+    volatile int64_t            done_us;          /* esp_timer time the last transfer left the wire */
+    BaseType_t                  woken;            /* set by an internal done_cb that woke a task, returned by the TX done ISR */
+    uint16_t                    reset_us;         /* idle LOW time required before the next frame (µs) */
+} parlio_tx_state_t;
+#endif
+
 // PARLIO hardware configuration (used by LiteLEDpio only)
 #if SOC_PARLIO_SUPPORTED
 typedef struct {
     parlio_tx_unit_handle_t     parlio_chan;      /* PARLIO TX unit handle */
     uint8_t                    *parlio_buf;       /* DMA-capable pre-encoded bitstream */
     size_t                      parlio_buf_bytes; /* size of the encoded bitstream in bytes */
+    uint32_t                    nib_lut[ 16 ][ PARLIO_MAX_SAMPLES_PER_BIT ]; /* 4 LED bits -> 4 x samples_per_bit DMA bytes as words */
+    uint16_t                    pack_lut[ 16 ];   /* packed mode: 4 LED bits -> 4 x samples_per_bit samples, MSB first */
+    uint8_t                     data_width;       /* PARLIO data width: 1 = packed, 8 = one DMA byte per sample */
+    size_t                      stream_chunk;     /* streaming: DMA bytes per ping-pong half, 0 = whole frame */
+    uint8_t                    *parlio_back;      /* second frame buffer, encoded while parlio_buf is sent; NULL until showAsync() */
+    size_t                      back_lo;          /* pixel bytes [back_lo, back_hi) parlio_back lacks besides the strip's dirty range */
+    size_t                      back_hi;
+    int8_t                      share_lane;       /* data line on the shared TX unit, -1 = owns its TX unit */
+    parlio_tx_state_t           tx_state;         /* TX done state shared with the ISR */
 } parlio_strip_cfg_t;
 #endif
 
@@ -122,11 +184,14 @@ typedef struct {
     size_t length;
     uint8_t brightness;
     uint8_t bright_act;
+    uint8_t bright_lut[ 256 ];   /* brightness scaling table, rebuilt when brightness changes */
     uint8_t gpio;
     uint8_t type;
     bool is_rgbw;
     bool auto_w;
     bool use_psram;
+    size_t dirty_lo;             /* pixel bytes [dirty_lo, dirty_hi) changed since the last PARLIO encode */
+    size_t dirty_hi;             /* empty when dirty_lo >= dirty_hi */
     led_strip_cfg_t stripCfg;
 } led_strip_t;
 
@@ -136,20 +201,31 @@ typedef struct {
 typedef struct {
     led_strip_t   strip;     /* pixel colour buffer and LED metadata for this lane */
     bool          assigned;  /* true once addStrip() claims this lane */
+    size_t        back_lo;   /* pixel bytes [back_lo, back_hi) the group's parlio_back lacks besides the dirty range */
+    size_t        back_hi;
 } parlio_lane_t;
 
 // Group hardware configuration — owns the PARLIO TX unit and shared DMA buffer,
-// plus per-lane pixel colour buffers for up to PARLIO_TX_UNIT_MAX_DATA_WIDTH strips.
+// plus one pixel arena sliced into per-lane colour buffers for up to
+// PARLIO_TX_UNIT_MAX_DATA_WIDTH strips.
 typedef struct {
     parlio_tx_unit_handle_t  parlio_chan;                              /* PARLIO TX unit handle */
     uint8_t                 *parlio_buf;                              /* shared DMA bitstream */
     size_t                   parlio_buf_bytes;                        /* size of the DMA buffer */
     parlio_lane_t            lanes[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];  /* per-lane state */
+    uint8_t                 *pixels;                                  /* one allocation holding every lane's pixel buffer */
     uint8_t                  lane_count;                              /* number of assigned lanes */
+    uint8_t                  data_width;                              /* TX unit width: 1, 2, 4, 8 or 16 lines */
+    size_t                   stream_chunk;                            /* streaming: DMA bytes per ping-pong half, 0 = whole frame */
+    uint8_t                 *parlio_back;                             /* second frame buffer; NULL until showAsync() */
+    parlio_tx_state_t        tx_state;                                /* TX done state shared with the ISR */
 } parlio_group_cfg_t;
 #endif
 
 
+// default refresh period of hold() when the frame is replayed by a timer
+#define LL_HOLD_REFRESH_MS_DEFAULT 100
+
 // defines for setting the led encoder DMA usage
 enum ll_dma_t : uint32_t {
     DMA_ON = 1,
@@ -172,6 +248,13 @@ enum ll_psram_t : uint32_t {
     PSRAM_AUTO = 2  // Automatically use PSRAM if available
 };
 
+// defines for the LiteLEDpio DMA bitstream layout
+enum ll_pack_t : uint32_t {
+    PACK_OFF = 0,           // One DMA byte per PARLIO sample (data_width = 8)
+    PACK_ON = 1,            // Eight samples per DMA byte (data_width = 1): 1/8 of the DMA RAM
+    PACK_DEFAULT = PACK_ON
+};
+
 // Inline helper functions for capability checking
 namespace LiteLED_Utils {
     // Check if DMA is supported on this chip at compile time
@@ -219,9 +302,48 @@ class LiteLED {
     // @return 'ESP_OK' on success
     esp_err_t begin( uint8_t data_pin, size_t length, ll_dma_t dma_flag, ll_priority_t priority, ll_psram_t psram_flag, bool auto_w = true );
 
+    // @brief Initialize the strip with DMA, interrupt priority, PSRAM and encoder options
+    // @param data_pin GPIO pin connected to the DIN pin of the strip
+    // @param length Number of LED's in the strip
+    // @param dma_flag Enumerated value that sets the DMA usage of the led encoder
+    // @param priority Enumerated value that sets the interrupt priority of led encoder callback
+    // @param psram_flag Enumerated value that sets the PSRAM usage preference for the LED buffer
+    // @param enc_flag Enumerated value that selects the RMT led encoder
+    // @param auto_w Optional. Only used for RGBW strips. Set false to not use the automatic W channel value set by the library
+    // @return 'ESP_OK' on success
+    esp_err_t begin( uint8_t data_pin, size_t length, ll_dma_t dma_flag, ll_priority_t priority, ll_psram_t psram_flag, ll_encoder_t enc_flag, bool auto_w = true );
+
     // @brief Flush the the LED buffer to the strip
     esp_err_t show();
 
+    // @brief Start sending the LED buffer to the strip and return without waiting for it to finish
+    // @return 'ESP_OK' on success
+    esp_err_t showAsync();
+
+    // @brief Check if a frame started by show() or showAsync() is still being sent
+    // @return true while the frame is on the wire
+    bool isBusy() const;
+
+    // @brief Wait for the frame started by showAsync() to finish
+    // @param timeout_ms Optional. Maximum time to wait in milliseconds, -1 to wait forever
+    // @return 'ESP_OK' when done, 'ESP_ERR_TIMEOUT' if the frame is still being sent
+    esp_err_t waitShow( int32_t timeout_ms = -1 );
+
+    // @brief Set a function to call each time a frame has been sent. Runs in interrupt context
+    // @param callback Function to call, or NULL to remove it. Must be short and placed in IRAM
+    // @param arg Optional. Argument passed to the callback
+    void onShowDone( ll_show_done_cb_t callback, void *arg = NULL );
+
+    // @brief Encode the LED buffer once and keep refreshing the strip with it until the next show()
+    //        Only a frame of a few LEDs fits a hardware loop; nearly every strip is refreshed by a timer.
+    // @param refresh_ms Optional. Refresh period used when the frame is too long for a hardware loop
+    // @return 'ESP_OK' on success
+    esp_err_t hold( uint32_t refresh_ms = LL_HOLD_REFRESH_MS_DEFAULT );
+
+    // @brief Check if the strip is being refreshed by hold()
+    // @return true if a held frame is being replayed
+    bool isHolding() const;
+
     // @brief Set color of single LED in strip, optionally flush the buffer to the strip
     // @param num Position of the LED in the strip, 0-based
     // @param color rgb_t or crgb_t Color to set the LED to
@@ -296,6 +418,10 @@ class LiteLED {
         return theStrip.gpio >= 0 ? ( int )theStrip.gpio : -1;
     }
 
+    // @brief Get the expected number of RMT interrupts needed to send one frame
+    // @return Estimated interrupt count per show(), 0 while a hold() hardware loop is running or if not initialized
+    size_t getRefillInterrupts();
+
     // @brief Static method to check if a GPIO is available for LiteLED use
     // @param gpio_pin GPIO pin number to check
     // @return true if available, false if in use by another peripheral
@@ -353,9 +479,40 @@ class LiteLEDpio {
     // @return ESP_OK on success.
     esp_err_t begin( uint8_t data_pin, size_t length, ll_psram_t psram_flag, bool auto_w = true );
 
-    // @brief Encode the LED colour buffer and transmit via PARLIO DMA.
+    // @brief Initialize the strip with PSRAM and DMA bitstream packing options.
+    // @param data_pin   GPIO pin connected to DIN of the strip.
+    // @param length     Number of LEDs in the strip.
+    // @param psram_flag PSRAM usage preference for the LED colour buffer.
+    // @param pack_flag  Packed (data_width 1) or byte-per-sample (data_width 8) DMA bitstream.
+    // @param auto_w     Optional. RGBW strips only.
+    // @return ESP_OK on success.
+    esp_err_t begin( uint8_t data_pin, size_t length, ll_psram_t psram_flag, ll_pack_t pack_flag, bool auto_w = true );
+
+    // @brief Encode the LED colour buffer and transmit via PARLIO DMA. Returns once the frame has been sent.
+    //        With instances sharing the PARLIO TX unit, the frame also carries every strip staged by showAsync().
+    //        Blocking calls are not merged: each sends a frame as long as the longest sharing strip.
     esp_err_t show();
 
+    // @brief Encode the LED colour buffer and start sending it without waiting for the transfer.
+    //        The first call adds a second DMA frame buffer so the next frame is encoded while this one is sent.
+    //        With instances sharing the PARLIO TX unit, only stages the strip: the shared frame is sent once
+    //        every strip is staged, or LL_PARLIO_SHARE_WINDOW_US later.
+    // @return ESP_OK on success.
+    esp_err_t showAsync();
+
+    // @brief Check if a frame started by show() or showAsync() is still being sent.
+    bool isBusy() const;
+
+    // @brief Wait for the frame started by showAsync() to finish.
+    // @param timeout_ms Optional. Maximum time to wait in milliseconds, -1 to wait forever.
+    // @return ESP_OK when done, ESP_ERR_TIMEOUT if the frame is still being sent.
+    esp_err_t waitShow( int32_t timeout_ms = -1 );
+
+    // @brief Set a function to call each time a frame has been sent. Runs in interrupt context.
+    // @param callback Function to call, or NULL to remove it. Must be short and placed in IRAM.
+    // @param arg      Optional. Argument passed to the callback.
+    void onShowDone( ll_show_done_cb_t callback, void *arg = NULL );
+
     esp_err_t setPixel( size_t num, rgb_t color, bool show = false );
     esp_err_t setPixel( size_t num, crgb_t color, bool show = false );
     esp_err_t setPixels( size_t start, size_t len, rgb_t *data, bool show = false );
@@ -450,23 +607,29 @@ class LiteLEDpioLane {
 //
 // Owns one PARLIO TX unit and one DMA bitstream buffer shared by all lanes.
 // Each strip is registered via addStrip() before begin() is called.  Every
-// show() call (on the group or on any of its lanes) encodes ALL lane pixel
-// buffers into the DMA buffer and performs a single PARLIO transmission,
-// guaranteeing perfectly synchronised output across all strips.
+// show() call (on the group or on any of its lanes) encodes the lanes that
+// changed into the DMA buffer and sends ALL lanes in a single PARLIO
+// transmission, guaranteeing perfectly synchronised output across all strips.
 //
 // Constraints:
-//   - All strips must use the same LED type, length and RGBW flag.
+//   - Strips may differ in length and RGBW flag.  Their LED types must share
+//     one PARLIO clock and samples per bit (e.g. WS2812, SK6812 and SM16703,
+//     but not APA106).  The frame lasts as long as the longest strip.
 //   - Maximum concurrent strips: PARLIO_TX_UNIT_MAX_DATA_WIDTH
 //     (8 on ESP32-C6 / ESP32-H2,  16 on ESP32-P4).
-//   - Only one LiteLEDpioGroup instance can be active at a time
-//     (one PARLIO TX unit per group on C6 / H2).
+//   - One LiteLEDpioGroup per PARLIO TX unit (LL_PARLIO_TX_UNITS; one on
+//     ESP32-C6 / H2 / P4).  Only on chips with more units is showAll()
+//     available, to send several groups as one synchronised frame.
+//   - The TX unit runs 1, 2, 4, 8 or 16 data lines wide, whichever covers the
+//     highest lane; the DMA buffer scales with that width, so prefer the
+//     lowest lane numbers.
 // ===========================================================================
 class LiteLEDpioGroup {
   public:
-    // @brief Constructor. Defines the shared LED type, strip length and RGBW
-    //        flag that apply to every lane added with addStrip().
+    // @brief Constructor. Defines the LED type, strip length and RGBW flag of
+    //        every lane added with addStrip( gpio ).
     // @param led_type  LED strip protocol (e.g., LED_STRIP_WS2812).
-    // @param length    Number of LEDs in each strip (must be identical for all).
+    // @param length    Number of LEDs in each strip.
     // @param rgbw      true for RGBW strips (e.g., SK6812 RGBW).
     LiteLEDpioGroup( led_strip_type_t led_type, size_t length, bool rgbw );
     ~LiteLEDpioGroup();
@@ -478,17 +641,33 @@ class LiteLEDpioGroup {
     // @param gpio  GPIO pin connected to the strip DIN.
     LiteLEDpioLane &addStrip( uint8_t gpio );
 
+    // @brief As addStrip( gpio ), for a strip with its own LED type, length
+    //        and RGBW flag.  Returns a silent null lane if the LED type
+    //        cannot share the PARLIO clock of the strips already added.
+    // @param gpio      GPIO pin connected to the strip DIN.
+    // @param led_type  LED strip protocol of this strip.
+    // @param length    Number of LEDs in this strip.
+    // @param rgbw      true for an RGBW strip.
+    LiteLEDpioLane &addStrip( uint8_t gpio, led_strip_type_t led_type, size_t length, bool rgbw );
+
     // @brief Register a strip on an explicit bit lane.
     //        LANE is checked at compile time against PARLIO_TX_UNIT_MAX_DATA_WIDTH.
     // @tparam LANE  Bit-lane index (0 … PARLIO_TX_UNIT_MAX_DATA_WIDTH-1).
     // @param  gpio  GPIO pin connected to the strip DIN.
     template<uint8_t LANE>
     LiteLEDpioLane &addStrip( uint8_t gpio ) {
+        return addStrip<LANE>( gpio, _type, _length, _is_rgbw );
+    }
+
+    // @brief As addStrip<LANE>( gpio ), for a strip with its own LED type,
+    //        length and RGBW flag.
+    template<uint8_t LANE>
+    LiteLEDpioLane &addStrip( uint8_t gpio, led_strip_type_t led_type, size_t length, bool rgbw ) {
         static_assert( LANE < PARLIO_TX_UNIT_MAX_DATA_WIDTH,
                        "LiteLEDpioGroup::addStrip<LANE>: lane index exceeds PARLIO "
                        "data_width for this SoC "
                        "(ESP32-C6/H2 max is 7; ESP32-P4 max is 15)." );
-        return _addStrip( LANE, gpio );
+        return _addStrip( LANE, gpio, led_type, length, rgbw );
     }
 
     // @brief Allocate hardware.  Must be called after all addStrip() calls
@@ -502,6 +681,52 @@ class LiteLEDpioGroup {
     //        transmit.  Blocks until the full frame (including reset) is done.
     esp_err_t show();
 
+    // @brief As show(), but return as soon as the frame is queued.  The first
+    //        call adds a second shared DMA buffer so the next frame is encoded
+    //        while this one is sent.
+    esp_err_t showAsync();
+
+    // @brief Check if a frame started by show() or showAsync() is still being sent.
+    bool isBusy() const;
+
+    // @brief Wait for the frame started by showAsync() to finish.
+    // @param timeout_ms  Optional. Maximum wait in milliseconds, -1 to wait forever.
+    // @return ESP_OK when done, ESP_ERR_TIMEOUT if the frame is still being sent.
+    esp_err_t waitShow( int32_t timeout_ms = -1 );
+
+    // @brief Set a function to call each time a frame has been sent.  Runs in
+    //        interrupt context; must be short and placed in IRAM.
+    void onShowDone( ll_show_done_cb_t callback, void *arg = NULL );
+
+#if LL_PARLIO_TX_UNITS > 1
+    // @brief Send several groups as one frame: encode all of them, then start
+    //        their transfers back to back so every strip updates within a few
+    //        microseconds.  Blocks until all frames are done.  Groups must be
+    //        begun and not streamed (ESP_ERR_NOT_SUPPORTED).
+    //        Only on chips with more than one PARLIO TX unit.
+    // @param groups  The groups to send, at most one per PARLIO TX unit.
+    // @param count   Number of entries in groups.
+    static esp_err_t showAll( LiteLEDpioGroup *const groups[], uint8_t count );
+
+    // @brief As showAll(), but return as soon as all frames are queued.  Each
+    //        group adds its second DMA buffer as with showAsync().
+    static esp_err_t showAllAsync( LiteLEDpioGroup *const groups[], uint8_t count );
+#else
+    // @brief Not available: this chip has one PARLIO TX unit, so only one group
+    //        can run.  Put the strips on lanes of that group instead.
+    template <typename T = void>
+    static esp_err_t showAll( LiteLEDpioGroup *const groups[], uint8_t count ) {
+        static_assert( sizeof( T * ) == 0, "LiteLEDpioGroup::showAll() needs a chip with more than one PARLIO TX unit" );
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    template <typename T = void>
+    static esp_err_t showAllAsync( LiteLEDpioGroup *const groups[], uint8_t count ) {
+        static_assert( sizeof( T * ) == 0, "LiteLEDpioGroup::showAllAsync() needs a chip with more than one PARLIO TX unit" );
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+#endif
+
     // @brief Set the same brightness level on every lane simultaneously.
     esp_err_t brightness( uint8_t bright, bool show = false );
 
@@ -517,8 +742,13 @@ class LiteLEDpioGroup {
     }
 
   private:
-    LiteLEDpioLane &_addStrip( uint8_t lane_idx, uint8_t gpio );
+    LiteLEDpioLane &_addStrip( uint8_t lane_idx, uint8_t gpio,
+                               led_strip_type_t led_type, size_t length, bool rgbw );
     esp_err_t _free();
+    void _syncBrightness();
+#if LL_PARLIO_TX_UNITS > 1
+    static esp_err_t _showAll( LiteLEDpioGroup *const groups[], uint8_t count, bool async );
+#endif
 
     led_strip_type_t    _type;
     size_t              _length;
@@ -44,9 +44,16 @@ LiteLEDpio::LiteLEDpio( led_strip_type_t led_type, bool rgbw ) {
     theStrip.bright_act = 255;
     theStrip.buf        = NULL;
     theStrip.use_psram  = false;
+    theStrip.dirty_lo   = 0;
+    theStrip.dirty_hi   = 0;
     parlioCfg.parlio_chan      = NULL;
     parlioCfg.parlio_buf       = NULL;
     parlioCfg.parlio_buf_bytes = 0;
+    parlioCfg.parlio_back      = NULL;
+    parlioCfg.share_lane       = -1;
+    parlioCfg.tx_state.stream_sem = NULL;
+    parlioCfg.tx_state.done_cb    = NULL;
+    parlioCfg.tx_state.done_arg   = NULL;
     valid_instance = false;
 }
 
@@ -58,47 +65,7 @@ LiteLEDpio::~LiteLEDpio() {
 // begin() — simple form
 // -------------------------------------------------------------------------
 esp_err_t LiteLEDpio::begin( uint8_t data_pin, size_t length, bool auto_w ) {
-    if ( valid_instance ) {
-        log_d( "LiteLEDpio: already initialized, cleaning up first" );
-        free();
-    }
-
-    theStrip.gpio      = ( gpio_num_t )data_pin;
-    theStrip.length    = length;
-    theStrip.auto_w    = auto_w;
-    theStrip.use_psram = false;
-
-    if ( !perimanPinIsValid( data_pin ) ) {
-        log_d( "LiteLEDpio: GPIO %u is not valid", data_pin );
-        return ESP_ERR_INVALID_ARG;
-    }
-    peripheral_bus_type_t cur = perimanGetPinBusType( data_pin );
-    if ( cur != ESP32_BUS_TYPE_INIT ) {
-        log_d( "LiteLEDpio: GPIO %u already in use by %s",
-               data_pin, perimanGetTypeName( cur ) );
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    esp_err_t res = parlio_strip_init( &theStrip, &parlioCfg );
-    if ( res != ESP_OK ) {
-        return res;
-    }
-
-    res = parlio_strip_install( &theStrip, &parlioCfg );
-    if ( res != ESP_OK ) {
-        return res;
-    }
-
-    if ( !perimanSetPinBus( data_pin, LL_PARLIO_BUS_TYPE,
-                            ( void * )parlioCfg.parlio_chan, -1, -1 ) ) {
-        log_d( "LiteLEDpio: Peripheral Manager registration failed for GPIO %u", data_pin );
-        parlio_strip_free( &theStrip, &parlioCfg );
-        return ESP_ERR_INVALID_STATE;
-    }
-    perimanSetPinBusExtraType( data_pin, "LiteLEDpio" );
-
-    valid_instance = true;
-    return ESP_OK;
+    return begin( data_pin, length, PSRAM_DISABLE, PACK_DEFAULT, auto_w );
 }
 
 // -------------------------------------------------------------------------
@@ -106,6 +73,14 @@ esp_err_t LiteLEDpio::begin( uint8_t data_pin, size_t length, bool auto_w ) {
 // -------------------------------------------------------------------------
 esp_err_t LiteLEDpio::begin( uint8_t data_pin, size_t length,
                              ll_psram_t psram_flag, bool auto_w ) {
+    return begin( data_pin, length, psram_flag, PACK_DEFAULT, auto_w );
+}
+
+// -------------------------------------------------------------------------
+// begin() — with PSRAM and packing options
+// -------------------------------------------------------------------------
+esp_err_t LiteLEDpio::begin( uint8_t data_pin, size_t length,
+                             ll_psram_t psram_flag, ll_pack_t pack_flag, bool auto_w ) {
     if ( valid_instance ) {
         log_d( "LiteLEDpio: already initialized, cleaning up first" );
         free();
@@ -141,14 +116,20 @@ esp_err_t LiteLEDpio::begin( uint8_t data_pin, size_t length,
     if ( res != ESP_OK ) {
         return res;
     }
+    parlioCfg.data_width = ( pack_flag == PACK_ON ) ? 1 : 8;
 
     res = parlio_strip_install( &theStrip, &parlioCfg );
+    if ( res == ESP_ERR_NOT_FOUND ) {
+        // No free TX unit: join the other LiteLEDpio instances on a shared one.
+        res = parlio_strip_share( &theStrip, &parlioCfg );
+    }
     if ( res != ESP_OK ) {
         return res;
     }
 
-    if ( !perimanSetPinBus( data_pin, LL_PARLIO_BUS_TYPE,
-                            ( void * )parlioCfg.parlio_chan, -1, -1 ) ) {
+    // The TX unit handle changes whenever a shared unit is rebuilt, so the
+    // instance itself is the bus handle.
+    if ( !perimanSetPinBus( data_pin, LL_PARLIO_BUS_TYPE, ( void * )this, -1, -1 ) ) {
         log_d( "LiteLEDpio: Peripheral Manager registration failed for GPIO %u", data_pin );
         parlio_strip_free( &theStrip, &parlioCfg );
         return ESP_ERR_INVALID_STATE;
@@ -174,6 +155,39 @@ esp_err_t LiteLEDpio::show() {
     return res;
 }
 
+// -------------------------------------------------------------------------
+// showAsync() — encode buffer → back DMA buffer → queue, no wait
+// -------------------------------------------------------------------------
+esp_err_t LiteLEDpio::showAsync() {
+    if ( !isValid() ) {
+        log_d( "LiteLEDpio::showAsync(): instance is no longer valid" );
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t res = parlio_strip_flush_async( &theStrip, &parlioCfg );
+    if ( res == ESP_OK ) {
+        theStrip.bright_act = theStrip.brightness;
+    }
+    return res;
+}
+
+bool LiteLEDpio::isBusy() const {
+    return ( parlioCfg.tx_state.tx_busy != 0 );
+}
+
+esp_err_t LiteLEDpio::waitShow( int32_t timeout_ms ) {
+    if ( !isValid() ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return parlio_strip_wait( &parlioCfg, timeout_ms );
+}
+
+void LiteLEDpio::onShowDone( ll_show_done_cb_t callback, void *arg ) {
+    // Clear the callback first so the ISR never sees a new callback paired with the old argument
+    parlioCfg.tx_state.done_cb  = NULL;
+    parlioCfg.tx_state.done_arg = arg;
+    parlioCfg.tx_state.done_cb  = callback;
+}
+
 // -------------------------------------------------------------------------
 // Pixel operations — delegate to the shared ll_strip_pixels layer
 // -------------------------------------------------------------------------
@@ -5,8 +5,9 @@
 
     LiteLEDpioGroup owns one PARLIO TX unit and one shared DMA bitstream
     buffer.  Each strip is registered as a bit-lane (0..data_width-1) via
-    addStrip().  Every show() call encodes ALL lane pixel buffers in a single
-    DMA transfer, guaranteeing perfectly synchronised output.
+    addStrip(), with the group's LED type, length and RGBW flag or its own.
+    Every show() call sends ALL lanes in a single DMA transfer, guaranteeing
+    perfectly synchronised output.
 
     LiteLEDpioLane is a thin reference class.  Its pixel methods operate on
     the pixel colour buffer for one lane; show() delegates to the parent
@@ -197,7 +198,8 @@ LiteLEDpioGroup::~LiteLEDpioGroup() {
 // -------------------------------------------------------------------------
 // _addStrip — internal: assign gpio to a specific bit lane
 // -------------------------------------------------------------------------
-LiteLEDpioLane &LiteLEDpioGroup::_addStrip( uint8_t lane_idx, uint8_t gpio ) {
+LiteLEDpioLane &LiteLEDpioGroup::_addStrip( uint8_t lane_idx, uint8_t gpio,
+                                            led_strip_type_t led_type, size_t length, bool rgbw ) {
     if ( _valid ) {
         log_e( "LiteLEDpioGroup::addStrip: cannot add strips after begin() — ignored" );
         return _null_lane;
@@ -213,18 +215,34 @@ LiteLEDpioLane &LiteLEDpioGroup::_addStrip( uint8_t lane_idx, uint8_t gpio ) {
         log_e( "LiteLEDpioGroup::addStrip: lane %u already assigned — ignored", lane_idx );
         return _null_lane;
     }
+    if ( led_type >= LED_STRIP_TYPE_MAX || length == 0 ) {
+        log_e( "LiteLEDpioGroup::addStrip: invalid LED type %u or length %u — ignored",
+               led_type, length );
+        return _null_lane;
+    }
+    // All lanes run on one clock: the LED types must share its waveform.
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( _groupCfg.lanes[ n ].assigned &&
+                !parlio_led_fits( _groupCfg.lanes[ n ].strip.type, led_type ) ) {
+            log_e( "LiteLEDpioGroup::addStrip: LED type %u cannot share the PARLIO clock of lane %u — ignored",
+                   led_type, n );
+            return _null_lane;
+        }
+    }
 
-    // Populate this lane's led_strip_t with shared parameters.
+    // Populate this lane's led_strip_t.
     led_strip_t &strip = _groupCfg.lanes[ lane_idx ].strip;
-    strip.type         = _type;
-    strip.length       = _length;
-    strip.is_rgbw      = _is_rgbw;
+    strip.type         = led_type;
+    strip.length       = length;
+    strip.is_rgbw      = rgbw;
     strip.auto_w       = true;
     strip.gpio         = ( gpio_num_t )gpio;
     strip.brightness   = _brightness;
     strip.bright_act   = _brightness;
     strip.buf          = NULL;
     strip.use_psram    = false;
+    strip.dirty_lo     = 0;
+    strip.dirty_hi     = 0;
 
     _groupCfg.lanes[ lane_idx ].assigned = true;
     _groupCfg.lane_count++;
@@ -232,7 +250,7 @@ LiteLEDpioLane &LiteLEDpioGroup::_addStrip( uint8_t lane_idx, uint8_t gpio ) {
     // Init the lane handle to point at this strip and back to this group.
     _lanes[ lane_idx ]._init( &strip, this );
 
-    log_d( "LiteLEDpioGroup::addStrip: lane %u → GPIO %u", lane_idx, gpio );
+    log_d( "LiteLEDpioGroup::addStrip: lane %u → GPIO %u (%u LEDs)", lane_idx, gpio, length );
     return _lanes[ lane_idx ];
 }
 
@@ -240,9 +258,13 @@ LiteLEDpioLane &LiteLEDpioGroup::_addStrip( uint8_t lane_idx, uint8_t gpio ) {
 // addStrip — sequential: assigns the next available lane
 // -------------------------------------------------------------------------
 LiteLEDpioLane &LiteLEDpioGroup::addStrip( uint8_t gpio ) {
+    return addStrip( gpio, _type, _length, _is_rgbw );
+}
+
+LiteLEDpioLane &LiteLEDpioGroup::addStrip( uint8_t gpio, led_strip_type_t led_type, size_t length, bool rgbw ) {
     for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
         if ( !_groupCfg.lanes[ n ].assigned ) {
-            return _addStrip( n, gpio );
+            return _addStrip( n, gpio, led_type, length, rgbw );
         }
     }
     log_e( "LiteLEDpioGroup::addStrip: all %d lanes assigned — ignored",
@@ -297,6 +319,9 @@ esp_err_t LiteLEDpioGroup::begin( ll_psram_t psram_flag ) {
     }
 
     esp_err_t res = parlio_group_install( &_groupCfg );
+    if ( res == ESP_ERR_NOT_FOUND ) {
+        log_e( "LiteLEDpioGroup::begin: no PARLIO TX unit free (%d on this chip)", LL_PARLIO_TX_UNITS );
+    }
     if ( res != ESP_OK ) {
         return res;
     }
@@ -337,16 +362,89 @@ esp_err_t LiteLEDpioGroup::show() {
     }
     esp_err_t res = parlio_group_flush( &_groupCfg );
     if ( res == ESP_OK ) {
-        // Sync bright_act for all lanes.
-        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-            if ( _groupCfg.lanes[ n ].assigned ) {
-                _groupCfg.lanes[ n ].strip.bright_act =
-                    _groupCfg.lanes[ n ].strip.brightness;
-            }
+        _syncBrightness();
+    }
+    return res;
+}
+
+// -------------------------------------------------------------------------
+// showAsync / isBusy / waitShow / onShowDone
+// -------------------------------------------------------------------------
+esp_err_t LiteLEDpioGroup::showAsync() {
+    if ( !_valid ) {
+        log_d( "LiteLEDpioGroup::showAsync: not initialized" );
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t res = parlio_group_flush_async( &_groupCfg );
+    if ( res == ESP_OK ) {
+        _syncBrightness();
+    }
+    return res;
+}
+
+#if LL_PARLIO_TX_UNITS > 1
+// -------------------------------------------------------------------------
+// showAll / showAllAsync — several groups as one frame
+// -------------------------------------------------------------------------
+esp_err_t LiteLEDpioGroup::showAll( LiteLEDpioGroup *const groups[], uint8_t count ) {
+    return _showAll( groups, count, false );
+}
+
+esp_err_t LiteLEDpioGroup::showAllAsync( LiteLEDpioGroup *const groups[], uint8_t count ) {
+    return _showAll( groups, count, true );
+}
+
+esp_err_t LiteLEDpioGroup::_showAll( LiteLEDpioGroup *const groups[], uint8_t count, bool async ) {
+    if ( !groups || count == 0 || count > LL_PARLIO_TX_UNITS ) {
+        log_e( "LiteLEDpioGroup::showAll: %u groups, at most %d on this chip", count, LL_PARLIO_TX_UNITS );
+        return ESP_ERR_INVALID_ARG;
+    }
+    parlio_group_cfg_t *cfgs[ LL_PARLIO_TX_UNITS ];
+    for ( uint8_t k = 0; k < count; k++ ) {
+        if ( !groups[ k ] || !groups[ k ]->_valid ) {
+            log_d( "LiteLEDpioGroup::showAll: group %u not initialized", k );
+            return ESP_ERR_INVALID_STATE;
+        }
+        cfgs[ k ] = &groups[ k ]->_groupCfg;
+    }
+    esp_err_t res = async ? parlio_groups_flush_async( cfgs, count )
+                          : parlio_groups_flush( cfgs, count );
+    if ( res == ESP_OK ) {
+        for ( uint8_t k = 0; k < count; k++ ) {
+            groups[ k ]->_syncBrightness();
         }
     }
     return res;
 }
+#endif
+
+// Sync bright_act for all lanes after a frame was sent.
+void LiteLEDpioGroup::_syncBrightness() {
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( _groupCfg.lanes[ n ].assigned ) {
+            _groupCfg.lanes[ n ].strip.bright_act =
+                _groupCfg.lanes[ n ].strip.brightness;
+        }
+    }
+}
+
+bool LiteLEDpioGroup::isBusy() const {
+    return ( _groupCfg.tx_state.tx_busy != 0 );
+}
+
+esp_err_t LiteLEDpioGroup::waitShow( int32_t timeout_ms ) {
+    if ( !_valid ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return parlio_group_wait( &_groupCfg, timeout_ms );
+}
+
+void LiteLEDpioGroup::onShowDone( ll_show_done_cb_t callback, void *arg ) {
+    // Clear the callback first so the ISR never sees a new callback paired with the old argument
+    _groupCfg.tx_state.done_cb  = NULL;
+    _groupCfg.tx_state.done_arg = arg;
+    _groupCfg.tx_state.done_cb  = callback;
+}
 
 // -------------------------------------------------------------------------
 // brightness — sets all lanes to the same value
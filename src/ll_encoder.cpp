@@ -1,54 +1,132 @@
 //
 /*
-    LiteLED RMT Encoder Callback Implementation
+    LiteLED RMT Encoder Callbacks Implementation
 */
 
 #include "ll_encoder.h"
+#include <string.h>
 
-size_t led_encoder_cb( const void* data, size_t data_size,
-                       size_t symbols_written, size_t symbols_free,
-                       rmt_symbol_word_t *symbols, bool *done, void *arg ) {
+// Byte-to-symbol lookup tables, one per LED type, with a count of the strips using each
+static rmt_symbol_word_t *ll_symbol_lut[ LED_STRIP_TYPE_MAX ] = { NULL };
+static uint8_t ll_symbol_lut_refs[ LED_STRIP_TYPE_MAX ] = { 0 };
 
-    // We need a minimum of 8 symbol spaces to encode a byte. We only
-    // need one to encode a reset, but it's simpler to simply demand that
-    // there are 8 symbol spaces free to write anything.
-    if ( symbols_free < 8 ) {
-        return 0;
+const rmt_symbol_word_t *ll_symbol_lut_acquire( uint8_t type ) {
+    /* Returns the shared byte-to-symbol table for the LED type, building it if needed */
+    if ( type >= LED_STRIP_TYPE_MAX ) {
+        return NULL;
     }
 
-    led_strip_t *strip = ( led_strip_t* )arg; // Cast arg to led_strip_t*
-    uint8_t *data_bytes = ( uint8_t* )data;
-    uint8_t photons = strip->brightness;      // Get the brightness value
+    if ( !ll_symbol_lut[ type ] ) {
+        rmt_symbol_word_t *lut = ( rmt_symbol_word_t* )heap_caps_malloc( LL_SYMBOL_LUT_ENTRIES * sizeof( rmt_symbol_word_t ),
+                                 MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+        if ( !lut ) {
+            log_d( "Error: Failed to allocate the %s symbol lookup table.", led_type[ type ] );
+            return NULL;
+        }
+        for ( int value = 0; value < 256; value++ ) {
+            rmt_symbol_word_t *row = &lut[ value * 8 ];
+            for ( int bit = 0; bit < 8; bit++ ) {
+                row[ bit ] = ( value & ( 0x80 >> bit ) ) ? led_params[ type ].led_1 : led_params[ type ].led_0;
+            }
+        }
+        ll_symbol_lut[ type ] = lut;
+        log_d( "Built the %s symbol lookup table (%d bytes).", led_type[ type ], LL_SYMBOL_LUT_ENTRIES * sizeof( rmt_symbol_word_t ) );
+    }
+
+    ll_symbol_lut_refs[ type ]++;
+    return ll_symbol_lut[ type ];
+}
 
-    // Retrieve the current position from enc_pos
-    size_t data_pos = strip->stripCfg.enc_pos;
+void ll_symbol_lut_release( uint8_t type ) {
+    /* Drops a reference to the shared table, freeing it when the last strip lets go */
+    if ( type >= LED_STRIP_TYPE_MAX || ll_symbol_lut_refs[ type ] == 0 ) {
+        return;
+    }
+    if ( --ll_symbol_lut_refs[ type ] == 0 ) {
+        heap_caps_free( ll_symbol_lut[ type ] );
+        ll_symbol_lut[ type ] = NULL;
+        log_d( "Freed the %s symbol lookup table.", led_type[ type ] );
+    }
+}
 
-    if ( data_pos < data_size ) {
-        // Encode a data byte with brightness scaling
-        uint8_t currentByte = scale8_video( data_bytes[ data_pos ], photons );
+size_t ll_frame_encode( led_strip_t *strip, const uint8_t *data, size_t size ) {
+    /* Expands the whole LED buffer into the frame symbol buffer, outside of the ISR */
+    const uint8_t *bright_lut = strip->bright_lut;
+    const rmt_symbol_word_t *lut = strip->stripCfg.sym_lut;
+    rmt_symbol_word_t *out = strip->stripCfg.frame_buf;
 
-        // Convert the byte to RMT symbols (8 bits = 8 symbols)
-        size_t symbol_pos = 0;
-        for ( int bitmask = 0x80; bitmask != 0; bitmask >>= 1 ) {
-            symbols[ symbol_pos++ ] = ( currentByte & bitmask ) ?
-                                      led_params[ strip->type ].led_1 :
-                                      led_params[ strip->type ].led_0;
+    size_t i = 0;
+    while ( i < size ) {
+        uint8_t value = bright_lut[ data[ i ] ];
+        size_t run = 1;
+        while ( i + run < size && bright_lut[ data[ i + run ] ] == value ) {
+            run++;
         }
+        // Expand the first byte of the run, then double the expanded block until the run is covered
+        memcpy( out, &lut[ value * 8 ], 8 * sizeof( rmt_symbol_word_t ) );
+        size_t done = 1;
+        while ( done < run ) {
+            size_t n = ( run - done < done ) ? run - done : done;
+            memcpy( out + done * 8, out, n * 8 * sizeof( rmt_symbol_word_t ) );
+            done += n;
+        }
+        out += run * 8;
+        i += run;
+    }
+    *out++ = led_params[ strip->type ].led_reset;
 
-        // Update the current position in the buffer
-        strip->stripCfg.enc_pos++;
+    return ( size_t )( out - strip->stripCfg.frame_buf );
+}
+
+static esp_err_t ll_staged_encoder_del( rmt_encoder_t *encoder ) {
+    ll_staged_encoder_t *led_encoder = __containerof( encoder, ll_staged_encoder_t, base );
+    rmt_del_encoder( led_encoder->bytes_encoder );
+    rmt_del_encoder( led_encoder->copy_encoder );
+    heap_caps_free( led_encoder );
+    return ESP_OK;
+}
+
+esp_err_t ll_staged_encoder_new( uint8_t type, rmt_encoder_handle_t *ret_encoder ) {
+    /* Builds the bytes + copy encoder pair used by ENCODER_STAGED */
+    if ( !( type < LED_STRIP_TYPE_MAX && ret_encoder ) ) {
+        log_d( "Error: Invalid arguments." );
+        return ESP_ERR_INVALID_ARG;
+    }
 
-        // We should have written 8 symbols
-        return symbol_pos;
+    ll_staged_encoder_t *led_encoder = ( ll_staged_encoder_t* )heap_caps_calloc( 1, sizeof( ll_staged_encoder_t ),
+                                       MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+    if ( !led_encoder ) {
+        log_d( "Error: Failed to allocate the staged encoder - ESP_ERR_NO_MEM." );
+        return ESP_ERR_NO_MEM;
     }
-    else {
-        // All bytes have been encoded.
-        // Encode the reset symbol, and we're done.
-        symbols[ 0 ] = led_params[ strip->type ].led_reset;
-        strip->stripCfg.enc_pos = 0;    // Reset the position in the buffer
-        *done = 1;                      // Indicate end of the transaction
-        return 1;                       // We only wrote one symbol
+    led_encoder->base.encode = ll_staged_encode;
+    led_encoder->base.del = ll_staged_encoder_del;
+    led_encoder->base.reset = ll_staged_encoder_reset;
+    led_encoder->reset_code = led_params[ type ].led_reset;
+
+    rmt_bytes_encoder_config_t bytes_encoder_config = {};
+    bytes_encoder_config.bit0 = led_params[ type ].led_0;
+    bytes_encoder_config.bit1 = led_params[ type ].led_1;
+    bytes_encoder_config.flags.msb_first = 1;   // LED data goes out MSB first
+
+    esp_err_t res = rmt_new_bytes_encoder( &bytes_encoder_config, &led_encoder->bytes_encoder );
+    if ( res != ESP_OK ) {
+        log_d( "Error: Failed to create the bytes encoder - %s.", esp_err_to_name( res ) );
+        heap_caps_free( led_encoder );
+        return res;
     }
+
+    rmt_copy_encoder_config_t copy_encoder_config = {};
+    res = rmt_new_copy_encoder( &copy_encoder_config, &led_encoder->copy_encoder );
+    if ( res != ESP_OK ) {
+        log_d( "Error: Failed to create the copy encoder - %s.", esp_err_to_name( res ) );
+        rmt_del_encoder( led_encoder->bytes_encoder );
+        heap_caps_free( led_encoder );
+        return res;
+    }
+
+    *ret_encoder = &led_encoder->base;
+    return ESP_OK;
 }
 
 //  --- EOF --- //
@@ -1,10 +1,27 @@
 //
 /*
-    LiteLED RMT Encoder Callback
+    LiteLED RMT Encoder Callbacks
 
     The encoder callback is called by the RMT driver when it needs more symbols to send.
     It pulls bytes from the LED data buffer and encodes them into RMT symbols with
-    brightness scaling applied.
+    brightness scaling applied through the strip's brightness lookup table.
+
+    Two callbacks are provided:
+        led_encoder_cb       - encodes one LED data byte per call (ENCODER_BYTE)
+        led_encoder_batch_cb - encodes whole bytes until the free symbol space is used up (ENCODER_BATCH)
+
+    Both callbacks convert a byte to its 8 RMT symbols by copying a row of a byte-to-symbol
+    lookup table. There is one table per LED type, built on first use and shared by every strip
+    of that type.
+
+    The callbacks, and the ENCODER_STAGED encode / reset callbacks, are implemented in
+    ll_encoder_isr.cpp and only read internal RAM, so they keep running with
+    CONFIG_RMT_ISR_IRAM_SAFE while the flash cache is disabled. That file poisons the flash-resident
+    timing tables; the reset symbol is read from the DRAM copy in stripCfg.reset_sym (or reset_code).
+
+    A third, callback-free encoder is provided for ENCODER_STAGED: an rmt_encoder_t that chains
+    the IDF bytes encoder (LED data) with the IDF copy encoder (reset symbol). Brightness is
+    applied into a staging buffer before rmt_transmit(), so the ISR does no per-byte work of its own.
 */
 
 #ifndef __LL_ENCODER_H__
@@ -14,6 +31,32 @@
 #include "llrgb.h"
 #include "ll_led_timings.h"
 
+// Set when the RMT ISR must keep working with the flash cache disabled
+#if CONFIG_RMT_ISR_IRAM_SAFE
+    #define LL_ISR_IRAM_SAFE 1
+#else
+    #define LL_ISR_IRAM_SAFE 0
+#endif
+
+#define LL_SYMBOL_LUT_ENTRIES ( 256 * 8 )   /* 8 RMT symbols for each of the 256 byte values */
+
+// String names for the led encoder modes, indexed by ll_encoder_t (for debugging, in ll_strip_core.cpp)
+extern const char *const ll_encoder_name[];
+
+/*
+    Get the byte-to-symbol lookup table for an LED type, building it on first use.
+    Row n (LL_SYMBOL_LUT_ENTRIES / 256 symbols) holds the RMT symbols for byte value n, MSB first.
+    The table is allocated in internal DRAM so it is safe to read from the RMT ISR. Each call must
+    be matched by a call to ll_symbol_lut_release() for the same type.
+
+    Returns:
+        Pointer to the table, or NULL if it could not be allocated
+*/
+const rmt_symbol_word_t *ll_symbol_lut_acquire( uint8_t type );
+
+// Release a reference to the lookup table for an LED type, freeing it when no strip uses it
+void ll_symbol_lut_release( uint8_t type );
+
 /*
     The encoder_callback() function is called by the RMT driver when it needs more symbols to send.
     The encoder_callback() pulls bytes of data from the LED data buffer and encodes them into RMT symbols,
@@ -36,6 +79,71 @@ IRAM_ATTR size_t led_encoder_cb( const void* data, size_t data_size,
                                   size_t symbols_written, size_t symbols_free,
                                   rmt_symbol_word_t *symbols, bool *done, void *arg );
 
+/*
+    The led_encoder_batch_cb() function is a drop-in alternative to led_encoder_cb().
+    Rather than returning after a single byte, it keeps encoding whole bytes (8 symbols each)
+    until fewer than 8 symbol spaces remain, then appends the reset symbol if the end of the
+    LED data has been reached and there is room for it. The position in the LED data buffer is
+    kept in strip->stripCfg.enc_pos across calls, exactly as with led_encoder_cb().
+
+    This cuts the number of callback invocations per frame from one per byte to roughly one per
+    free RMT memory block, which significantly lowers the RMT interrupt load for long strips.
+
+    Parameters and return value are identical to led_encoder_cb().
+*/
+IRAM_ATTR size_t led_encoder_batch_cb( const void* data, size_t data_size,
+                                        size_t symbols_written, size_t symbols_free,
+                                        rmt_symbol_word_t *symbols, bool *done, void *arg );
+
+/*
+    Create the ENCODER_STAGED encoder for an LED type: an IDF bytes encoder using the type's
+    led_0 / led_1 symbols (MSB first) followed by a copy encoder that emits the led_reset symbol.
+    The data passed to rmt_transmit() must already be brightness scaled.
+
+    Parameters:
+        type        - [in] LED strip type (index into led_params[])
+        ret_encoder - [out] Handle of the new encoder; delete with rmt_del_encoder()
+
+    Returns:
+        'ESP_OK' on success
+*/
+esp_err_t ll_staged_encoder_new( uint8_t type, rmt_encoder_handle_t *ret_encoder );
+
+// ENCODER_STAGED: bytes encoder for the LED data chained with a copy encoder for the reset
+typedef struct {
+    rmt_encoder_t base;                 /* must be first; the RMT driver calls through this */
+    rmt_encoder_handle_t bytes_encoder; /* expands LED data bytes to led_0 / led_1 symbols */
+    rmt_encoder_handle_t copy_encoder;  /* emits the reset symbol */
+    int state;                          /* 0 = sending data, 1 = sending reset */
+    rmt_symbol_word_t reset_code;       /* copy of the reset symbol for this LED type */
+} ll_staged_encoder_t;
+
+/*
+    The ENCODER_STAGED encode and reset callbacks installed by ll_staged_encoder_new(). The RMT
+    driver calls them from its ISR, so like the simple encoder callbacks they live in
+    ll_encoder_isr.cpp and read the reset symbol from the DRAM copy in reset_code.
+*/
+IRAM_ATTR size_t ll_staged_encode( rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                                   const void *primary_data, size_t data_size,
+                                   rmt_encode_state_t *ret_state );
+IRAM_ATTR esp_err_t ll_staged_encoder_reset( rmt_encoder_t *encoder );
+
+/*
+    Encode an entire frame into an RMT symbol array (ENCODER_FRAME). Each LED data byte is passed
+    through the brightness table and expanded to 8 symbols from the byte-to-symbol lookup table;
+    the reset symbol is written after the last byte. Runs in task context from led_strip_flush().
+    A run of identical bytes is expanded once and then doubled in place with memcpy.
+
+    Parameters:
+        strip   - [in] LED strip; strip->stripCfg.frame_buf must hold PIXEL_SIZE * 8 + 1 symbols
+        data    - [in] LED buffer data
+        size    - [in] Size of the LED buffer data in bytes
+
+    Returns:
+        Number of symbols written to strip->stripCfg.frame_buf
+*/
+size_t ll_frame_encode( led_strip_t *strip, const uint8_t *data, size_t size );
+
 #endif /* __LL_ENCODER_H__ */
 
 //  --- EOF --- //
@@ -0,0 +1,151 @@
+//
+/*
+    LiteLED RMT Encoder Callbacks Implementation - ISR Path
+
+    The simple encoder callbacks and the ENCODER_STAGED encode / reset callbacks run in the RMT
+    interrupt. With CONFIG_RMT_ISR_IRAM_SAFE that interrupt keeps running while the flash cache
+    is disabled (NVS writes, OTA), so nothing called or read from here may live in flash. The callbacks only read:
+        - the led_strip_t object (internal RAM), including bright_lut[] and stripCfg.reset_sym
+        - the shared symbol lookup table (internal DRAM, see ll_symbol_lut_acquire())
+        - the LED pixel buffer (internal RAM when LL_ISR_IRAM_SAFE, see led_strip_install())
+        - the ll_staged_encoder_t object and its reset_code copy (internal RAM)
+
+    The flash-resident timing tables are poisoned below, so any use of them in this file is a
+    compile error rather than a glitch during a flash write.
+*/
+
+#include "ll_encoder.h"
+#include <string.h>
+
+#pragma GCC poison led_params led_type parlio_led_params ll_encoder_name
+
+size_t led_encoder_cb( const void* data, size_t data_size,
+                       size_t symbols_written, size_t symbols_free,
+                       rmt_symbol_word_t *symbols, bool *done, void *arg ) {
+
+    // We need a minimum of 8 symbol spaces to encode a byte. We only
+    // need one to encode a reset, but it's simpler to simply demand that
+    // there are 8 symbol spaces free to write anything.
+    if ( symbols_free < 8 ) {
+        return 0;
+    }
+
+    led_strip_t *strip = ( led_strip_t* )arg; // Cast arg to led_strip_t*
+    uint8_t *data_bytes = ( uint8_t* )data;
+
+    // Retrieve the current position from enc_pos
+    size_t data_pos = strip->stripCfg.enc_pos;
+
+    if ( data_pos < data_size ) {
+        // Encode a data byte with brightness scaling
+        uint8_t currentByte = strip->bright_lut[ data_bytes[ data_pos ] ];
+
+        // Convert the byte to RMT symbols (8 bits = 8 symbols)
+        memcpy( symbols, &strip->stripCfg.sym_lut[ currentByte * 8 ], 8 * sizeof( rmt_symbol_word_t ) );
+
+        // Update the current position in the buffer
+        strip->stripCfg.enc_pos++;
+
+        // We should have written 8 symbols
+        return 8;
+    }
+    else {
+        // All bytes have been encoded.
+        // Encode the reset symbol, and we're done.
+        symbols[ 0 ] = strip->stripCfg.reset_sym;
+        strip->stripCfg.enc_pos = 0;    // Reset the position in the buffer
+        *done = 1;                      // Indicate end of the transaction
+        return 1;                       // We only wrote one symbol
+    }
+}
+
+size_t led_encoder_batch_cb( const void* data, size_t data_size,
+                             size_t symbols_written, size_t symbols_free,
+                             rmt_symbol_word_t *symbols, bool *done, void *arg ) {
+
+    // Same rule as led_encoder_cb(): don't write anything unless a whole byte fits.
+    if ( symbols_free < 8 ) {
+        return 0;
+    }
+
+    led_strip_t *strip = ( led_strip_t* )arg;
+    const uint8_t *data_bytes = ( const uint8_t* )data;
+    const uint8_t *bright_lut = strip->bright_lut;
+    const rmt_symbol_word_t *lut = strip->stripCfg.sym_lut;
+
+    size_t data_pos = strip->stripCfg.enc_pos;
+    size_t symbol_pos = 0;
+
+    // Encode whole bytes for as long as there is room for all 8 of their symbols
+    while ( data_pos < data_size && symbols_free - symbol_pos >= 8 ) {
+        uint8_t currentByte = bright_lut[ data_bytes[ data_pos++ ] ];
+        memcpy( &symbols[ symbol_pos ], &lut[ currentByte * 8 ], 8 * sizeof( rmt_symbol_word_t ) );
+        symbol_pos += 8;
+    }
+
+    if ( data_pos < data_size ) {
+        // Out of symbol space, more data to come. Remember where we stopped.
+        strip->stripCfg.enc_pos = data_pos;
+        return symbol_pos;
+    }
+
+    if ( symbol_pos < symbols_free ) {
+        // All bytes have been encoded and there is room for the reset symbol.
+        symbols[ symbol_pos++ ] = strip->stripCfg.reset_sym;
+        strip->stripCfg.enc_pos = 0;    // Reset the position in the buffer
+        *done = 1;                      // Indicate end of the transaction
+        return symbol_pos;
+    }
+
+    // All bytes encoded but the block is full; the reset goes out on the next call.
+    strip->stripCfg.enc_pos = data_pos;
+    return symbol_pos;
+}
+
+size_t ll_staged_encode( rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                         const void *primary_data, size_t data_size,
+                         rmt_encode_state_t *ret_state ) {
+    ll_staged_encoder_t *led_encoder = __containerof( encoder, ll_staged_encoder_t, base );
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    int state = RMT_ENCODING_RESET;
+    size_t encoded_symbols = 0;
+
+    if ( led_encoder->state == 0 ) {
+        // Send the LED data
+        encoded_symbols += led_encoder->bytes_encoder->encode( led_encoder->bytes_encoder, channel,
+                           primary_data, data_size, &session_state );
+        if ( session_state & RMT_ENCODING_COMPLETE ) {
+            led_encoder->state = 1;     // Data done, move on to the reset
+        }
+        if ( session_state & RMT_ENCODING_MEM_FULL ) {
+            *ret_state = ( rmt_encode_state_t )( state | RMT_ENCODING_MEM_FULL );
+            return encoded_symbols;     // Out of symbol space, yield
+        }
+    }
+
+    if ( led_encoder->state == 1 ) {
+        // Send the reset symbol
+        encoded_symbols += led_encoder->copy_encoder->encode( led_encoder->copy_encoder, channel,
+                           &led_encoder->reset_code, sizeof( led_encoder->reset_code ), &session_state );
+        if ( session_state & RMT_ENCODING_COMPLETE ) {
+            led_encoder->state = 0;     // Back to the start for the next transaction
+            state |= RMT_ENCODING_COMPLETE;
+        }
+        if ( session_state & RMT_ENCODING_MEM_FULL ) {
+            state |= RMT_ENCODING_MEM_FULL;
+        }
+    }
+
+    *ret_state = ( rmt_encode_state_t )state;
+    return encoded_symbols;
+}
+
+esp_err_t ll_staged_encoder_reset( rmt_encoder_t *encoder ) {
+    ll_staged_encoder_t *led_encoder = __containerof( encoder, ll_staged_encoder_t, base );
+    rmt_encoder_reset( led_encoder->bytes_encoder );
+    rmt_encoder_reset( led_encoder->copy_encoder );
+    led_encoder->state = 0;
+    return ESP_OK;
+}
+
+//  --- EOF --- //
@@ -2,12 +2,15 @@
 /*
     LiteLED LED Timing Definitions
 
-    RMT symbol timing definitions for various LED strip types:
+    One nanosecond timing spec per LED strip type:
     - WS2812 / WS2812B
     - WS2812 RGB variant
     - APA106
     - SM16703
     - SK6812
+
+    The RMT symbol table (led_params) and the PARLIO waveform table
+    (parlio_led_params) are both generated from it at compile time.
 */
 
 #ifndef __LL_LED_TIMINGS_H__
@@ -17,138 +20,70 @@
 
 #define RMT_LED_STRIP_RESOLUTION_HZ 10000000    /* 10 MHz resolution, 1 tick = 0.1us (led strip needs a high resolution) */
 
-// WS2812 / WS2812B timing (most common addressable LEDs)
-static const rmt_symbol_word_t ws2812_zero = {
-    static_cast<uint16_t>( 0.3 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T0H=0.3us
-    1,                                                                      // .level0
-    static_cast<uint16_t>( 0.9 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T0L=0.9us
-    0                                                                       // .level1
-};
-
-static const rmt_symbol_word_t ws2812_one = {
-    static_cast<uint16_t>( 0.9 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T1H=0.9us
-    1,                                                                      // .level0
-    static_cast<uint16_t>( 0.3 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T1L=0.3us
-    0                                                                       // .level1
-};
-
-static const rmt_symbol_word_t ws2812_reset = {                                 /* WS2812 reset is 50uS */
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 50 / 2 ),    //.duration0 = 25us
-    0,                                                                          // .level0
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 50 / 2 ),    //.duration1 = 25us
-    0                                                                           // .level1
-};
-
-// APA106 timing
-static const rmt_symbol_word_t apa106_zero = {
-    static_cast<uint16_t>( 0.35 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T0H=0.35us
-    1,                                                                       // .level0
-    static_cast<uint16_t>( 1.36 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T0L=1.36us
-    0                                                                        // .level1
-};
-
-static const rmt_symbol_word_t apa106_one = {
-    static_cast<uint16_t>( 1.36 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T1H=1.36us
-    1,                                                                       // .level0
-    static_cast<uint16_t>( 0.35 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T1L=0.35us
-    0                                                                        // .level1
-};
-
-static const rmt_symbol_word_t apa106_reset = {                                 /* APA106 reset is 50uS */
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 50 / 2 ),    //.duration0 = 25us
-    0,                                                                          // .level0
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 50 / 2 ),    //.duration1 = 25us
-    0                                                                           // .level1
-};
-
-// SM16703 timing
-static const rmt_symbol_word_t sm16703_zero = {
-    static_cast<uint16_t>( 0.3 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T0H=0.3us
-    1,                                                                      // .level0
-    static_cast<uint16_t>( 0.9 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T0L=0.9us
-    0                                                                       // .level1
-};
-
-static const rmt_symbol_word_t sm16703_one = {
-    static_cast<uint16_t>( 0.9 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T1H=0.9us
-    1,                                                                      // .level0
-    static_cast<uint16_t>( 0.3 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration1 = T1L=0.3us
-    0                                                                       // .level1
-};
-
-static const rmt_symbol_word_t sm16703_reset = {                                /* SM16703 reset is 210uS */
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 210 / 2 ),   //.duration0 = 105us
-    0,                                                                          // .level0
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 210 / 2 ),   //.duration1 = 105us
-    0                                                                           // .level1
-};
-
-// SK6812 timing (RGBW LEDs)
-static const rmt_symbol_word_t sk6812_zero = {
-    static_cast<uint16_t>( 0.32 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T0H=0.32us
-    1,                                                                       // .level0
-    static_cast<uint16_t>( 0.9 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),    // .duration1 = T0L=0.9us
-    0                                                                        // .level1
-};
-
-static const rmt_symbol_word_t sk6812_one = {
-    static_cast<uint16_t>( 0.64 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),   // .duration0 = T1H=0.64us
-    1,                                                                       // .level0
-    static_cast<uint16_t>( 0.4 * RMT_LED_STRIP_RESOLUTION_HZ / 1000000 ),    // .duration1 = T1L=0.4us
-    0                                                                        // .level1
-};
-
-static const rmt_symbol_word_t sk6812_reset = {                                 /* SK6812 reset is 90uS */
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 90 / 2 ),    //.duration0 = 45us
-    0,                                                                          // .level0
-    static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * 90 / 2 ),    //.duration1 = 45us
-    0                                                                           // .level1
-};
-
-// LED type parameter structures (combine timing + color order)
-static const led_params_t led_ws2812 = {
-    .led_0 = ws2812_zero,
-    .led_1 = ws2812_one,
-    .led_reset = ws2812_reset,
-    .order = ORDER_GRB      // Standard WS2812 color order
-};
-
-static const led_params_t led_ws2812_rgb = {
-    /* Some "WS2812" LEDs have non-standard RGB colour order */
-    .led_0 = ws2812_zero,
-    .led_1 = ws2812_one,
-    .led_reset = ws2812_reset,
-    .order = ORDER_RGB
-};
-
-static const led_params_t led_apa106 = {
-    .led_0 = apa106_zero,
-    .led_1 = apa106_one,
-    .led_reset = apa106_reset,
-    .order = ORDER_RGB
-};
-
-static const led_params_t led_sm16703 = {
-    .led_0 = sm16703_zero,
-    .led_1 = sm16703_one,
-    .led_reset = sm16703_reset,
-    .order = ORDER_RGB
+// -------------------------------------------------------------------------
+// LED timing specs
+// -------------------------------------------------------------------------
+// High / low times of a 0 bit and a 1 bit, the reset (latch) time and the
+// allowed deviation of each high / low time.  Adding a type here is enough
+// for both drivers.
+typedef struct {
+    uint16_t      t0h_ns;           /* 0 bit: high time */
+    uint16_t      t0l_ns;           /* 0 bit: low time */
+    uint16_t      t1h_ns;           /* 1 bit: high time */
+    uint16_t      t1l_ns;           /* 1 bit: low time */
+    uint16_t      reset_us;         /* low time that latches the data */
+    uint16_t      tol_ns;           /* allowed deviation of each high / low time */
+    color_order_t order;            /* native colour order */
+} led_timing_t;
+
+static constexpr led_timing_t led_timing[] = {
+    //                           T0H   T0L   T1H   T1L  reset  tol  order
+    [ LED_STRIP_WS2812 ]     = { 300,  900,  900,  300,   50, 150, ORDER_GRB },
+    [ LED_STRIP_WS2812_RGB ] = { 300,  900,  900,  300,   50, 150, ORDER_RGB },     /* some "WS2812" LEDs have RGB order */
+    [ LED_STRIP_SK6812 ]     = { 320,  900,  900,  300,  210, 150, ORDER_GRB },     /* 1 bit and reset as SM16703 */
+    [ LED_STRIP_APA106 ]     = { 350, 1360, 1360,  350,   50, 150, ORDER_RGB },
+    [ LED_STRIP_SM16703 ]    = { 300,  900,  900,  300,  210, 150, ORDER_RGB }
 };
 
-static const led_params_t led_sk6812 = {
-    .led_0 = sk6812_zero,
-    .led_1 = sm16703_one,
-    .led_reset = sm16703_reset,
-    .order = ORDER_GRB
-};
+// -------------------------------------------------------------------------
+// RMT symbols
+// -------------------------------------------------------------------------
+// Durations are whole RMT ticks, rounded down (350 ns → 3 ticks).  The reset
+// symbol is two low halves of reset_us / 2 each.
+static constexpr rmt_symbol_word_t ll_rmt_bit_symbol( uint16_t high_ns, uint16_t low_ns ) {
+    return {
+        static_cast<uint16_t>( high_ns / ( 1000000000UL / RMT_LED_STRIP_RESOLUTION_HZ ) ),    // .duration0
+        1,                                                                                      // .level0
+        static_cast<uint16_t>( low_ns / ( 1000000000UL / RMT_LED_STRIP_RESOLUTION_HZ ) ),     // .duration1
+        0                                                                                       // .level1
+    };
+}
+
+static constexpr rmt_symbol_word_t ll_rmt_reset_symbol( uint16_t reset_us ) {
+    return {
+        static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * reset_us / 2 ),        // .duration0
+        0,                                                                                      // .level0
+        static_cast<uint16_t>( RMT_LED_STRIP_RESOLUTION_HZ / 1000000 * reset_us / 2 ),        // .duration1
+        0                                                                                       // .level1
+    };
+}
+
+static constexpr led_params_t ll_rmt_params( const led_timing_t &t ) {
+    return {
+        ll_rmt_bit_symbol( t.t0h_ns, t.t0l_ns ),
+        ll_rmt_bit_symbol( t.t1h_ns, t.t1l_ns ),
+        ll_rmt_reset_symbol( t.reset_us ),
+        t.order
+    };
+}
 
 // LED parameters lookup table indexed by led_strip_type_t
-static const led_params_t led_params[] = {
-    [ LED_STRIP_WS2812 ]     = led_ws2812,
-    [ LED_STRIP_WS2812_RGB ] = led_ws2812_rgb,
-    [ LED_STRIP_SK6812 ]     = led_sk6812,
-    [ LED_STRIP_APA106 ]     = led_apa106,
-    [ LED_STRIP_SM16703 ]    = led_sm16703
+static constexpr led_params_t led_params[] = {
+    [ LED_STRIP_WS2812 ]     = ll_rmt_params( led_timing[ LED_STRIP_WS2812 ] ),
+    [ LED_STRIP_WS2812_RGB ] = ll_rmt_params( led_timing[ LED_STRIP_WS2812_RGB ] ),
+    [ LED_STRIP_SK6812 ]     = ll_rmt_params( led_timing[ LED_STRIP_SK6812 ] ),
+    [ LED_STRIP_APA106 ]     = ll_rmt_params( led_timing[ LED_STRIP_APA106 ] ),
+    [ LED_STRIP_SM16703 ]    = ll_rmt_params( led_timing[ LED_STRIP_SM16703 ] )
 };
 
 // String names for LED types (for debugging)
@@ -178,19 +113,26 @@ static bool use_custom_color_order = false;
 // -------------------------------------------------------------------------
 // PARLIO timing parameters
 // -------------------------------------------------------------------------
-// All supported LED types are driven at 2.5 MHz with 3 samples per bit.
-// Each LED data bit maps to 3 PARLIO clock cycles (400 ns each):
+// Each LED data bit is samples_per_bit PARLIO clock cycles; a 0 bit holds
+// the line high for the first h0 of them, a 1 bit for the first h1.  For
+// every type parlio_led_synth() picks, at compile time:
 //
-//   LED bit 0  →  [HIGH, LOW,  LOW ] → T0H = 400 ns, T0L = 800 ns
-//   LED bit 1  →  [HIGH, HIGH, LOW ] → T1H = 800 ns, T1L = 400 ns
+//   * the fewest samples per bit (3 .. PARLIO_MAX_SAMPLES_PER_BIT) for which
+//     some h0 < h1 and sample time keep all four high / low times within
+//     tol_ns.  Fewer samples means a lower clock, a smaller DMA buffer and
+//     less encoding work.
+//   * within that, the sample time (whole ns) with the smallest worst-case
+//     error, the longer one on a tie.
 //
-// This satisfies WS2812 / WS2813 / SK6812 / SM16703 timing requirements.
+//   WS2812   3 samples of 400 ns (2.5 MHz):  0 = [H L L], 1 = [H H L]
+//   APA106   4 samples of 428 ns (2.34 MHz): 0 = [H L L L], 1 = [H H H L]
 //
-// APA106 note: the datasheet T0L minimum (1210 ns) is not met at this
-// clock rate (T0L = 800 ns). Works in practice but is an approximation.
-// A future refinement can add per-type clock rates for strict compliance.
+// The TX unit divides its source clock down to clk_hz, so the sample time
+// on the wire can differ by a few ns from the one chosen here.
 //
-// Reset: 125 zero-bytes × 8 bits × 400 ns = 400 µs LOW — covers all types.
+// Reset: no samples are sent for it.  The data line idles LOW after each
+// frame and the next frame starts no sooner than reset_us later, the same
+// latch time the RMT reset symbol of that type gives.
 // -------------------------------------------------------------------------
 
 #ifndef SOC_PARLIO_SUPPORTED
@@ -199,31 +141,91 @@ static bool use_custom_color_order = false;
 
 #if SOC_PARLIO_SUPPORTED
 
-#define PARLIO_LED_STRIP_CLK_HZ  2500000UL  // 2.5 MHz → 400 ns per PARLIO clock
-#define PARLIO_SAMPLES_PER_BIT   3          // PARLIO clock cycles per LED data bit
-#define PARLIO_BIT0_PATTERN      0x04       // 0b100 : clocks high, low,  low
-#define PARLIO_BIT1_PATTERN      0x06       // 0b110 : clocks high, high, low
-// data_width=8: each DMA byte = 1 PARLIO clock = 400 ns.
-// Each LED data bit expands to (PARLIO_SAMPLES_PER_BIT * 8) = 24 DMA bytes.
-// Reset: 1000 zero-bytes × 400 ns = 400 µs LOW, satisfies all supported LED types.
-#define PARLIO_BYTES_PER_BIT     ( PARLIO_SAMPLES_PER_BIT * 8 )   // 24 DMA bytes per LED bit
-#define PARLIO_RESET_BYTES       1000
-
 typedef struct {
     uint32_t      clk_hz;           /* PARLIO output clock frequency (Hz) */
     uint8_t       samples_per_bit;  /* PARLIO clock cycles per LED protocol data bit */
     uint8_t       bit0_pattern;     /* Bit pattern for LED data 0 (MSB = first sample out) */
     uint8_t       bit1_pattern;     /* Bit pattern for LED data 1 (MSB = first sample out) */
     color_order_t order;            /* LED colour order (shared with RMT led_params) */
+    uint16_t      reset_us;         /* LOW time between frames that latches the data (µs) */
 } parlio_led_params_t;
 
-static const parlio_led_params_t parlio_led_params[] = {
-    [ LED_STRIP_WS2812     ] = { PARLIO_LED_STRIP_CLK_HZ, PARLIO_SAMPLES_PER_BIT, PARLIO_BIT0_PATTERN, PARLIO_BIT1_PATTERN, ORDER_GRB },
-    [ LED_STRIP_WS2812_RGB ] = { PARLIO_LED_STRIP_CLK_HZ, PARLIO_SAMPLES_PER_BIT, PARLIO_BIT0_PATTERN, PARLIO_BIT1_PATTERN, ORDER_RGB },
-    [ LED_STRIP_SK6812     ] = { PARLIO_LED_STRIP_CLK_HZ, PARLIO_SAMPLES_PER_BIT, PARLIO_BIT0_PATTERN, PARLIO_BIT1_PATTERN, ORDER_GRB },
-    [ LED_STRIP_APA106     ] = { PARLIO_LED_STRIP_CLK_HZ, PARLIO_SAMPLES_PER_BIT, PARLIO_BIT0_PATTERN, PARLIO_BIT1_PATTERN, ORDER_RGB },
-    [ LED_STRIP_SM16703    ] = { PARLIO_LED_STRIP_CLK_HZ, PARLIO_SAMPLES_PER_BIT, PARLIO_BIT0_PATTERN, PARLIO_BIT1_PATTERN, ORDER_RGB },
-};
+static constexpr uint32_t parlio_abs_diff( uint32_t a, uint32_t b ) {
+    return a > b ? a - b : b - a;
+}
+
+// Largest deviation from the spec when a sample lasts tick_ns and a 0 / 1
+// bit is high for h0 / h1 of s samples.
+static constexpr uint32_t parlio_timing_error( const led_timing_t &t, uint32_t tick_ns,
+                                               uint8_t s, uint8_t h0, uint8_t h1 ) {
+    uint32_t e0 = parlio_abs_diff( tick_ns * h0, t.t0h_ns );
+    uint32_t e1 = parlio_abs_diff( tick_ns * ( s - h0 ), t.t0l_ns );
+    uint32_t e2 = parlio_abs_diff( tick_ns * h1, t.t1h_ns );
+    uint32_t e3 = parlio_abs_diff( tick_ns * ( s - h1 ), t.t1l_ns );
+    uint32_t e  = e0 > e1 ? e0 : e1;
+    e = e > e2 ? e : e2;
+    return e > e3 ? e : e3;
+}
+
+// High samples first, MSB = first sample out.
+static constexpr uint8_t parlio_bit_pattern( uint8_t s, uint8_t high ) {
+    return ( uint8_t )( ( ( 1u << high ) - 1 ) << ( s - high ) );
+}
+
+// Returns samples_per_bit = 0 when no layout fits (caught by the
+// static_assert below).
+static constexpr parlio_led_params_t parlio_led_synth( const led_timing_t &t ) {
+    parlio_led_params_t best = { 0, 0, 0, 0, t.order, t.reset_us };
+    uint32_t best_err = 0;
+    for ( uint8_t s = 3; s <= PARLIO_MAX_SAMPLES_PER_BIT && best.samples_per_bit == 0; s++ ) {
+        // Bit periods within the tolerance bound the sample time.
+        uint32_t tick_lo = ( t.t0h_ns + t.t0l_ns - 2u * t.tol_ns ) / s;
+        uint32_t tick_hi = ( t.t0h_ns + t.t0l_ns + 2u * t.tol_ns ) / s;
+        for ( uint8_t h0 = 1; h0 < s; h0++ ) {
+            for ( uint8_t h1 = h0 + 1; h1 < s; h1++ ) {
+                for ( uint32_t tick = tick_lo ? tick_lo : 1; tick <= tick_hi; tick++ ) {
+                    uint32_t err = parlio_timing_error( t, tick, s, h0, h1 );
+                    if ( err <= t.tol_ns && ( best.samples_per_bit == 0 || err <= best_err ) ) {
+                        best.clk_hz          = 1000000000UL / tick;
+                        best.samples_per_bit = s;
+                        best.bit0_pattern    = parlio_bit_pattern( s, h0 );
+                        best.bit1_pattern    = parlio_bit_pattern( s, h1 );
+                        best_err             = err;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+static constexpr parlio_led_params_t parlio_led_params[] = {
+    [ LED_STRIP_WS2812     ] = parlio_led_synth( led_timing[ LED_STRIP_WS2812 ] ),
+    [ LED_STRIP_WS2812_RGB ] = parlio_led_synth( led_timing[ LED_STRIP_WS2812_RGB ] ),
+    [ LED_STRIP_SK6812     ] = parlio_led_synth( led_timing[ LED_STRIP_SK6812 ] ),
+    [ LED_STRIP_APA106     ] = parlio_led_synth( led_timing[ LED_STRIP_APA106 ] ),
+    [ LED_STRIP_SM16703    ] = parlio_led_synth( led_timing[ LED_STRIP_SM16703 ] ),
+};
+
+static_assert( parlio_led_params[ LED_STRIP_WS2812 ].samples_per_bit &&
+               parlio_led_params[ LED_STRIP_WS2812_RGB ].samples_per_bit &&
+               parlio_led_params[ LED_STRIP_SK6812 ].samples_per_bit &&
+               parlio_led_params[ LED_STRIP_APA106 ].samples_per_bit &&
+               parlio_led_params[ LED_STRIP_SM16703 ].samples_per_bit,
+               "led_timing: no PARLIO waveform within tolerance; raise PARLIO_MAX_SAMPLES_PER_BIT or tol_ns" );
+
+// DMA bytes one LED colour byte expands to at data_width lines: 8 bits of
+// samples_per_bit samples, data_width bits each.
+static constexpr size_t parlio_led_byte_bytes( uint8_t type, uint8_t data_width ) {
+    return ( size_t )parlio_led_params[ type ].samples_per_bit * data_width;
+}
+
+// LED types that run at the same clock with the same samples per bit can be
+// data lines of one TX unit; their bit patterns may differ.
+static constexpr bool parlio_led_fits( uint8_t a, uint8_t b ) {
+    return parlio_led_params[ a ].clk_hz == parlio_led_params[ b ].clk_hz &&
+           parlio_led_params[ a ].samples_per_bit == parlio_led_params[ b ].samples_per_bit;
+}
 
 #endif /* SOC_PARLIO_SUPPORTED */
 
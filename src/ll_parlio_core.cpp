@@ -9,6 +9,7 @@
 
 #include "llrgb.h"
 #include "ll_led_timings.h"
+#include "ll_strip_pixels.h"
 #include <string.h>
 
 // -------------------------------------------------------------------------
@@ -26,31 +27,343 @@
 #define PIO_COLOR_SIZE( strip ) ( 3 + ( (strip)->is_rgbw != 0 ) )
 #define PIO_PIXEL_SIZE( strip ) ( PIO_COLOR_SIZE( strip ) * (strip)->length )
 
+// PARLIO transaction queue depth; streaming keeps at most two chunks queued
+#define PIO_TRANS_QUEUE_DEPTH 4
+
+// A nibble is 4 x samples_per_bit samples: whole words in nib_lut (one DMA
+// byte per sample) and at most 16 bits in pack_lut (one bit per sample).
+static_assert( PARLIO_MAX_SAMPLES_PER_BIT * 4 <= 16, "pack_lut entries hold at most 16 samples" );
+
+// The LiteLEDpio that owns a TX unit by itself, if any.  parlio_strip_share()
+// moves it onto the shared unit when another instance finds no unit free.
+static led_strip_t        *pio_solo_strip = NULL;
+static parlio_strip_cfg_t *pio_solo_cfg   = NULL;
+
+static esp_err_t parlio_share_stage( led_strip_t *strip, parlio_strip_cfg_t *cfg );
+static esp_err_t parlio_share_wait( parlio_strip_cfg_t *cfg, int timeout_ms );
+static esp_err_t parlio_share_leave( led_strip_t *strip, parlio_strip_cfg_t *cfg );
+
 // -------------------------------------------------------------------------
-// Internal: encode one LED colour byte → PARLIO_BYTES_PER_BIT * 8 = 24 DMA bytes.
+// Internal: build the nibble expansion table for one LED type.
 //
 // data_width=8: each DMA byte = 1 PARLIO clock across all 8 lines.
 // Only data_gpio_nums[0] (bit 0) is wired to the LED strip:
 //   0x01 = bit0 HIGH = LED data high
 //   0x00 = bit0 LOW  = LED data low
 //
-// Each of the 8 input bits → 3 DMA bytes using the 3-bit sample pattern:
+// Each input bit → samples_per_bit DMA bytes from its sample pattern, e.g.
+// WS2812 (3 samples of 400 ns):
 //   bit-0 (0b100): 0x01 0x00 0x00  (T0H=400ns, T0L=800ns)
 //   bit-1 (0b110): 0x01 0x01 0x00  (T1H=800ns, T1L=400ns)
 //
-// No bit-packing, no DMA endianness issue.
+// Entry n holds the 4 x samples_per_bit DMA bytes for the 4 bits of nibble
+// n (MSB first), stored as samples_per_bit words in memory order, so the
+// encoder never touches bits.  A 16-entry table (256 bytes at most) gives
+// the same word stores as a 256-entry byte table would, for 1/32 of the
+// internal RAM.
 // -------------------------------------------------------------------------
-static IRAM_ATTR void parlio_encode_byte( uint8_t b,
-        uint8_t bit0_pat,
-        uint8_t bit1_pat,
+static void parlio_build_nib_lut( const parlio_led_params_t *p, uint32_t lut[ 16 ][ PARLIO_MAX_SAMPLES_PER_BIT ] ) {
+    const int spb = p->samples_per_bit;
+    for ( int nib = 0; nib < 16; nib++ ) {
+        uint8_t samples[ PARLIO_MAX_SAMPLES_PER_BIT * 4 ];
+        for ( int bit = 0; bit < 4; bit++ ) {
+            uint8_t pat = ( ( nib >> ( 3 - bit ) ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+            for ( int s = 0; s < spb; s++ ) {
+                // sample 0 is the MSB of the pattern
+                samples[ bit * spb + s ] = ( pat >> ( spb - 1 - s ) ) & 1;
+            }
+        }
+        memcpy( lut[ nib ], samples, 4 * spb );
+    }
+}
+
+// -------------------------------------------------------------------------
+// Internal: build the packed-mode nibble table for one LED type.
+//
+// data_width=1: every DMA byte carries 8 consecutive samples of the single
+// data line, sent MSB first (PARLIO_BIT_PACK_ORDER_MSB).  Entry n holds the
+// 4 x samples_per_bit samples for the 4 bits of nibble n, first sample in
+// the highest bit, so one input byte becomes exactly samples_per_bit DMA
+// bytes (3 for WS2812).
+// -------------------------------------------------------------------------
+static void parlio_build_pack_lut( const parlio_led_params_t *p, uint16_t lut[ 16 ] ) {
+    for ( int nib = 0; nib < 16; nib++ ) {
+        uint16_t v = 0;
+        for ( int bit = 0; bit < 4; bit++ ) {
+            uint8_t pat = ( ( nib >> ( 3 - bit ) ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+            v = ( uint16_t )( ( v << p->samples_per_bit ) | pat );
+        }
+        lut[ nib ] = v;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Internal: encode one LED colour byte → spb packed DMA bytes (data_width=1).
+// -------------------------------------------------------------------------
+static IRAM_ATTR void parlio_encode_byte_packed( uint8_t b,
+        const uint16_t lut[ 16 ], int spb,
         uint8_t *out ) {
-    for ( int i = 7; i >= 0; i-- ) {
-        uint8_t pat = ( ( b >> i ) & 1 ) ? bit1_pat : bit0_pat;
-        // expand 3-bit sample pattern, each bit → one full DMA byte on bit0
-        *out++ = ( pat >> 2 ) & 1;  // sample 0 (MSB of pattern)
-        *out++ = ( pat >> 1 ) & 1;  // sample 1
-        *out++ =   pat        & 1;  // sample 2 (LSB of pattern)
+    uint32_t v = ( ( uint32_t )lut[ b >> 4 ] << ( 4 * spb ) ) | lut[ b & 0x0F ];
+    for ( int k = spb - 1; k >= 0; k-- ) {
+        out[ k ] = ( uint8_t )v;
+        v >>= 8;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Internal: encode one LED colour byte → 8 x spb DMA bytes (24 for WS2812)
+// with 2 x spb aligned 32-bit stores.  out must be 4-byte aligned, which
+// holds for every byte slot because the DMA buffer is word aligned and each
+// slot is a whole number of words long.
+// -------------------------------------------------------------------------
+static IRAM_ATTR void parlio_encode_byte( uint8_t b,
+        const uint32_t lut[ 16 ][ PARLIO_MAX_SAMPLES_PER_BIT ], int spb,
+        uint32_t *out ) {
+    const uint32_t *hi = lut[ b >> 4 ];
+    const uint32_t *lo = lut[ b & 0x0F ];
+    for ( int k = 0; k < spb; k++ ) {
+        out[ k ]       = hi[ k ];
+        out[ spb + k ] = lo[ k ];
+    }
+}
+
+// -------------------------------------------------------------------------
+// Internal: replicate an already encoded block to cover a run of identical
+// input bytes.  out points at the first block (block_bytes long, already
+// written); the block is doubled in place until count blocks exist, so a
+// run of N bytes costs about log2(N) memcpy calls instead of N encodes.
+// -------------------------------------------------------------------------
+static void parlio_repeat_block( uint8_t *out, size_t block_bytes, size_t count ) {
+    size_t done = 1;
+    while ( done < count ) {
+        size_t n = ( count - done < done ) ? count - done : done;
+        memcpy( out + done * block_bytes, out, n * block_bytes );
+        done += n;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Streaming support
+//
+// A frame encoder writes count input bytes starting at input byte first to
+// out (count * block_bytes DMA bytes).  The same encoder serves the
+// whole-frame path (one call) and the streaming path (one call per chunk).
+// -------------------------------------------------------------------------
+typedef void ( *parlio_encode_fn_t )( void *ctx, size_t first, size_t count, uint8_t *out );
+
+// Returns the DMA bytes per ping-pong chunk for a frame of frame_bytes, or 0
+// when the frame is small enough for one whole-frame buffer.  Chunks hold
+// whole LED bytes and keep both halves word aligned.
+static size_t parlio_stream_chunk_bytes( size_t frame_bytes, size_t block_bytes ) {
+    if ( frame_bytes <= LL_PARLIO_STREAM_THRESHOLD ) {
+        return 0;
+    }
+    const size_t unit = block_bytes * 4;
+    return ( LL_PARLIO_STREAM_CHUNK_BYTES + unit - 1 ) / unit * unit;
+}
+
+// on_trans_done.  Stamps the end of the transfer for parlio_reset_gap().
+// Streaming: one chunk has left the wire.  Whole-frame: the frame has been
+// sent, so release it and run the user callback.
+static IRAM_ATTR bool parlio_tx_done( parlio_tx_unit_handle_t tx_unit,
+                                      const parlio_tx_done_event_data_t *edata,
+                                      void *user_ctx ) {
+    parlio_tx_state_t *st    = ( parlio_tx_state_t * )user_ctx;
+    BaseType_t         woken = pdFALSE;
+    st->done_us = esp_timer_get_time();
+    if ( st->stream_sem ) {
+        xSemaphoreGiveFromISR( st->stream_sem, &woken );
+    }
+    else if ( st->tx_busy ) {
+        st->tx_busy = 0;
+        st->woken   = pdFALSE;
+        ll_show_done_cb_t cb = st->done_cb;
+        if ( cb ) {
+            cb( st->done_arg );
+        }
+        if ( st->woken == pdTRUE ) {
+            woken = pdTRUE;
+        }
+    }
+    return woken == pdTRUE;
+}
+
+// Reset the TX state, create the chunk semaphore when streaming and register
+// the done callback.  Must run while the TX unit is still disabled.  The
+// line may have carried a frame until just now (a shared unit is rebuilt
+// right after its last transfer), so the first frame waits out a full reset.
+static esp_err_t parlio_tx_attach( parlio_tx_unit_handle_t chan, parlio_tx_state_t *st,
+                                   bool stream, uint16_t reset_us ) {
+    st->stream_sem = NULL;
+    st->tx_busy    = 0;
+    st->done_us    = esp_timer_get_time();
+    st->reset_us   = reset_us;
+    st->woken      = pdFALSE;
+    if ( stream ) {
+        st->stream_sem = xSemaphoreCreateCounting( PIO_TRANS_QUEUE_DEPTH, 0 );
+        if ( !st->stream_sem ) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    parlio_tx_event_callbacks_t cbs = {};
+    cbs.on_trans_done = parlio_tx_done;
+    esp_err_t res = parlio_tx_unit_register_event_callbacks( chan, &cbs, st );
+    if ( res != ESP_OK && st->stream_sem ) {
+        vSemaphoreDelete( st->stream_sem );
+        st->stream_sem = NULL;
+    }
+    return res;
+}
+
+// Release what parlio_tx_attach() and showAsync() added: the chunk semaphore
+// and the second frame buffer.
+static void parlio_tx_detach( parlio_tx_state_t *st, uint8_t **back ) {
+    if ( st->stream_sem ) {
+        vSemaphoreDelete( st->stream_sem );
+        st->stream_sem = NULL;
+    }
+    if ( *back ) {
+        heap_caps_free( *back );
+        *back = NULL;
+    }
+}
+
+// The latch reset is idle time, not DMA data: the line sits at idle_value 0
+// once a transfer ends.  Call after the previous transfer is done and right
+// before the next one is queued; waits out whatever part of reset_us the
+// encode has not already covered.
+static void parlio_reset_gap( const parlio_tx_state_t *st ) {
+    int64_t left = st->done_us + st->reset_us - esp_timer_get_time();
+    if ( left > 0 ) {
+        delayMicroseconds( ( uint32_t )left );
+    }
+}
+
+// Allocate the second whole-frame buffer on the first showAsync().  Returns
+// false (single buffering) for streamed frames or when RAM is short.
+static bool parlio_alloc_back( uint8_t **back, size_t bytes, size_t stream_chunk ) {
+    if ( *back || stream_chunk ) {
+        return *back != NULL;
+    }
+    *back = ( uint8_t * )heap_caps_calloc( 1, bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL );
+    if ( *back ) {
+        log_d( "PARLIO second frame buffer: %u bytes", bytes );
+    }
+    else {
+        log_d( "PARLIO second frame buffer alloc failed (%u bytes), showAsync() stays single buffered", bytes );
+    }
+    return *back != NULL;
+}
+
+// Make *front hold the next whole frame.  Only input bytes [first, first +
+// count) are encoded; the rest of the buffer must already hold this frame.
+// With a second buffer the new frame is encoded into *back while the
+// previous one is still on the wire; the buffers swap once that frame is
+// done.  Returns with the TX unit idle.
+static esp_err_t parlio_frame_prepare( parlio_tx_unit_handle_t chan,
+                                       uint8_t **front, uint8_t **back,
+                                       size_t first, size_t count, size_t block_bytes,
+                                       parlio_encode_fn_t encode, void *ctx ) {
+    esp_err_t res;
+    if ( *back ) {
+        if ( count ) {
+            encode( ctx, first, count, *back + first * block_bytes );
+        }
+        if ( ( res = parlio_tx_unit_wait_all_done( chan, -1 ) ) != ESP_OK ) {
+            return res;
+        }
+        uint8_t *t = *front;
+        *front = *back;
+        *back  = t;
+    }
+    else {
+        // One buffer: it is owned by the DMA until the previous frame is done.
+        if ( ( res = parlio_tx_unit_wait_all_done( chan, -1 ) ) != ESP_OK ) {
+            return res;
+        }
+        if ( count ) {
+            encode( ctx, first, count, *front + first * block_bytes );
+        }
+    }
+    return ESP_OK;
+}
+
+// Queue the bytes of front once the reset gap has passed.
+static esp_err_t parlio_frame_send( parlio_tx_unit_handle_t chan, parlio_tx_state_t *st,
+                                    const uint8_t *front, size_t bytes ) {
+    parlio_reset_gap( st );
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    st->tx_busy = 1;
+    esp_err_t res = parlio_tx_unit_transmit( chan, front, bytes * 8, &tx_cfg );
+    if ( res != ESP_OK ) {
+        st->tx_busy = 0;
+    }
+    return res;
+}
+
+// Send a whole frame from *front: parlio_frame_prepare(), then
+// parlio_frame_send().  Returns once the new frame is queued.
+static esp_err_t parlio_frame_start( parlio_tx_unit_handle_t chan, parlio_tx_state_t *st,
+                                     uint8_t **front, uint8_t **back, size_t bytes,
+                                     size_t first, size_t count, size_t block_bytes,
+                                     parlio_encode_fn_t encode, void *ctx ) {
+    esp_err_t res = parlio_frame_prepare( chan, front, back, first, count, block_bytes, encode, ctx );
+    if ( res != ESP_OK ) {
+        return res;
+    }
+    return parlio_frame_send( chan, st, *front, bytes );
+}
+
+// Stream one frame through the two chunk halves of buf.  While one half is
+// on the wire the other is encoded and queued behind it, so at most two
+// transfers are ever outstanding.  Blocks until the last chunk has been sent.
+// Between chunks the line idles LOW while the driver starts the next
+// transaction (a few µs); chunks end on LED byte boundaries, so this only
+// stretches one bit's LOW phase, and must stay well below reset_us.
+static esp_err_t parlio_stream_frame( parlio_tx_unit_handle_t chan, parlio_tx_state_t *st,
+                                      uint8_t *buf, size_t chunk, size_t block_bytes,
+                                      size_t input_bytes, parlio_encode_fn_t encode, void *ctx ) {
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    SemaphoreHandle_t        sem    = st->stream_sem;
+    const size_t per_chunk = chunk / block_bytes;
+    size_t       next      = 0;
+    uint8_t      in_flight = 0;
+    uint8_t      half      = 0;
+    esp_err_t    res       = ESP_OK;
+
+    while ( xSemaphoreTake( sem, 0 ) == pdTRUE ) {}     // drop stale completions
+
+    while ( next < input_bytes ) {
+        if ( in_flight == 2 ) {
+            xSemaphoreTake( sem, portMAX_DELAY );       // a half is free again
+            in_flight--;
+        }
+        uint8_t *out = buf + half * chunk;
+        size_t   n   = ( input_bytes - next < per_chunk ) ? input_bytes - next : per_chunk;
+        encode( ctx, next, n, out );
+        if ( next == 0 ) {
+            parlio_reset_gap( st );                     // latch the previous frame first
+        }
+        next += n;
+        size_t bytes = n * block_bytes;
+        if ( ( res = parlio_tx_unit_transmit( chan, out, bytes * 8, &tx_cfg ) ) != ESP_OK ) {
+            log_d( "parlio_stream_frame: transmit failed - %s", esp_err_to_name( res ) );
+            break;
+        }
+        in_flight++;
+        half ^= 1;
+    }
+
+    esp_err_t wres = parlio_tx_unit_wait_all_done( chan, -1 );
+    while ( xSemaphoreTake( sem, 0 ) == pdTRUE ) {}
+    if ( res == ESP_OK && wres == ESP_OK ) {
+        // Streamed frames end in this task, so the callback runs here.
+        ll_show_done_cb_t cb = st->done_cb;
+        if ( cb ) {
+            cb( st->done_arg );
+        }
     }
+    return ( res != ESP_OK ) ? res : wres;
 }
 
 // -------------------------------------------------------------------------
@@ -62,13 +375,23 @@ esp_err_t parlio_strip_init( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     cfg->parlio_chan      = NULL;
     cfg->parlio_buf       = NULL;
     cfg->parlio_buf_bytes = 0;
+    cfg->data_width       = 8;
+    cfg->stream_chunk     = 0;
+    cfg->parlio_back      = NULL;
+    cfg->back_lo          = 0;
+    cfg->back_hi          = 0;
+    cfg->share_lane       = -1;
+    cfg->tx_state.stream_sem = NULL;
+    cfg->tx_state.tx_busy    = 0;
     log_d( "parlio_strip_init: OK" );
     return ESP_OK;
 }
 
 // -------------------------------------------------------------------------
-esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
-    // ---- allocate pixel colour buffer (obeys PSRAM preference) -----------
+// Internal: allocate the pixel colour buffer (obeys the PSRAM preference)
+// and build the brightness table.
+// -------------------------------------------------------------------------
+static esp_err_t parlio_strip_alloc_pixels( led_strip_t *strip ) {
     size_t pixel_bytes = strip->length * PIO_COLOR_SIZE( strip );
 
     if ( strip->use_psram ) {
@@ -100,33 +423,61 @@ esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     }
 
     if ( !strip->buf ) {
-        log_d( "parlio_strip_install: failed to allocate pixel buffer" );
         return ESP_ERR_NO_MEM;
     }
+    led_strip_build_bright_lut( strip );
+    return ESP_OK;
+}
+
+// -------------------------------------------------------------------------
+// Internal: allocate the DMA buffers and create the strip's own TX unit for
+// its pixel buffer.  On failure everything it allocated is freed again and
+// the pixel buffer is kept.
+// -------------------------------------------------------------------------
+static esp_err_t parlio_strip_open( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    size_t pixel_bytes = strip->length * PIO_COLOR_SIZE( strip );
 
     // ---- allocate DMA bitstream buffer (must be internal DMA-capable RAM) -
     const parlio_led_params_t *p = &parlio_led_params[ strip->type ];
-    // data_width=8: each input byte expands to (samples_per_bit × 8) = 24 DMA bytes
-    size_t encoded_bytes  = pixel_bytes * p->samples_per_bit * 8;
-    size_t total_bytes    = encoded_bytes + PARLIO_RESET_BYTES;  // + 400 µs LOW
-    total_bytes           = ( total_bytes + 3 ) & ~( size_t )3;  // 4-byte aligned
+    const bool packed = ( cfg->data_width == 1 );
+    if ( packed ) {
+        parlio_build_pack_lut( p, cfg->pack_lut );
+    }
+    else {
+        cfg->data_width = 8;
+        parlio_build_nib_lut( p, cfg->nib_lut );
+    }
+    // data_width=8: each input byte expands to (samples_per_bit × 8) DMA bytes (24 for WS2812)
+    // data_width=1: the same samples pack into samples_per_bit DMA bytes
+    // The reset is idle time after the transfer and takes no DMA bytes.
+    const size_t block_bytes = parlio_led_byte_bytes( strip->type, cfg->data_width );
+    size_t encoded_bytes  = pixel_bytes * block_bytes;
+    size_t total_bytes    = ( encoded_bytes + 3 ) & ~( size_t )3;  // 4-byte aligned
 
-    cfg->parlio_buf = ( uint8_t* )heap_caps_calloc( 1, total_bytes,
+    // Long strips stream through two chunks instead of one whole frame.
+    cfg->stream_chunk = parlio_stream_chunk_bytes( total_bytes, block_bytes );
+    size_t buf_bytes  = cfg->stream_chunk ? cfg->stream_chunk * 2 : total_bytes;
+
+    cfg->parlio_buf = ( uint8_t* )heap_caps_calloc( 1, buf_bytes,
                       MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL );
     if ( !cfg->parlio_buf ) {
-        log_d( "parlio_strip_install: failed to allocate DMA bitstream buffer (%u bytes)", total_bytes );
-        free( strip->buf );
-        strip->buf = NULL;
+        log_d( "parlio_strip_install: failed to allocate DMA bitstream buffer (%u bytes)", buf_bytes );
         return ESP_ERR_NO_MEM;
     }
-    cfg->parlio_buf_bytes = total_bytes;
-    log_d( "PARLIO DMA buffer: %u bytes (%u encoded + %u reset, aligned)",
-           total_bytes, encoded_bytes, PARLIO_RESET_BYTES );
+    cfg->parlio_buf_bytes = buf_bytes;
+    if ( cfg->stream_chunk ) {
+        log_d( "PARLIO DMA buffer: 2 x %u byte stream chunks for a %u byte frame, data_width %u",
+               cfg->stream_chunk, total_bytes, cfg->data_width );
+    }
+    else {
+        log_d( "PARLIO DMA buffer: %u bytes (%u encoded, aligned, data_width %u, %u us reset)",
+               total_bytes, encoded_bytes, cfg->data_width, p->reset_us );
+    }
 
     // ---- create PARLIO TX unit -------------------------------------------
     parlio_tx_unit_config_t chan_cfg = {};
     chan_cfg.clk_src             = PARLIO_CLK_SRC_DEFAULT;
-    chan_cfg.data_width           = 8;    // 1 byte = 1 clock; bit0 = LED data pin
+    chan_cfg.data_width           = cfg->data_width;  // 8: 1 byte = 1 clock; 1: 1 byte = 8 clocks
     chan_cfg.clk_in_gpio_num      = GPIO_NUM_NC;  // no external clock input
     chan_cfg.clk_out_gpio_num     = GPIO_NUM_NC;  // no clock output (clockless protocol)
     chan_cfg.valid_gpio_num       = GPIO_NUM_NC;  // no valid signal output
@@ -135,9 +486,11 @@ esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     }
     chan_cfg.data_gpio_nums[ 0 ]  = ( gpio_num_t )strip->gpio;
     chan_cfg.output_clk_freq_hz   = p->clk_hz;
-    chan_cfg.trans_queue_depth    = 4;
-    chan_cfg.max_transfer_size    = total_bytes;
-    // No bit_pack_order setting needed for data_width=8 (no packing occurs)
+    chan_cfg.trans_queue_depth    = PIO_TRANS_QUEUE_DEPTH;
+    chan_cfg.max_transfer_size    = cfg->stream_chunk ? cfg->stream_chunk : total_bytes;
+    // Packed mode: first sample in the MSB of each byte, matching pack_lut
+    // (no packing occurs for data_width=8, so the order does not matter there)
+    chan_cfg.bit_pack_order       = PARLIO_BIT_PACK_ORDER_MSB;
     // idle_value is set per-transmit in parlio_transmit_config_t
     chan_cfg.flags.clk_gate_en    = false;
 
@@ -146,19 +499,18 @@ esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
         log_d( "parlio_strip_install: parlio_new_tx_unit() failed - %s", esp_err_to_name( res ) );
         heap_caps_free( cfg->parlio_buf );
         cfg->parlio_buf = NULL;
-        free( strip->buf );
-        strip->buf = NULL;
         return res;
     }
 
-    if ( ( res = parlio_tx_unit_enable( cfg->parlio_chan ) ) != ESP_OK ) {
-        log_d( "parlio_strip_install: parlio_tx_unit_enable() failed - %s", esp_err_to_name( res ) );
+    if ( ( res = parlio_tx_attach( cfg->parlio_chan, &cfg->tx_state,
+                                   cfg->stream_chunk != 0, p->reset_us ) ) != ESP_OK ||
+            ( res = parlio_tx_unit_enable( cfg->parlio_chan ) ) != ESP_OK ) {
+        log_d( "parlio_strip_install: TX unit callbacks / enable failed - %s", esp_err_to_name( res ) );
         parlio_del_tx_unit( cfg->parlio_chan );
         cfg->parlio_chan = NULL;
+        parlio_tx_detach( &cfg->tx_state, &cfg->parlio_back );
         heap_caps_free( cfg->parlio_buf );
         cfg->parlio_buf = NULL;
-        free( strip->buf );
-        strip->buf = NULL;
         return res;
     }
 
@@ -169,19 +521,35 @@ esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     parlio_strip_debug_dump( strip, cfg );
     #endif
 
+    pio_solo_strip = strip;
+    pio_solo_cfg   = cfg;
     return ESP_OK;
 }
 
 // -------------------------------------------------------------------------
-esp_err_t parlio_strip_free( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
-    if ( !cfg || !cfg->parlio_chan ) {
-        log_d( "parlio_strip_free: called on uninitialized config" );
-        return ESP_ERR_INVALID_ARG;
+esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    // ---- allocate pixel colour buffer (obeys PSRAM preference) -----------
+    if ( parlio_strip_alloc_pixels( strip ) != ESP_OK ) {
+        log_d( "parlio_strip_install: failed to allocate pixel buffer" );
+        return ESP_ERR_NO_MEM;
     }
 
+    esp_err_t res = parlio_strip_open( strip, cfg );
+    if ( res != ESP_OK ) {
+        free( strip->buf );
+        strip->buf = NULL;
+    }
+    return res;
+}
+
+// -------------------------------------------------------------------------
+// Internal: wait for any transfer, then delete the strip's own TX unit and
+// free its DMA buffers.  The pixel buffer is kept.
+// -------------------------------------------------------------------------
+static esp_err_t parlio_strip_release( parlio_strip_cfg_t *cfg ) {
     esp_err_t res;
 
-    // Wait for any in-progress DMA transfer (including reset period)
+    // Wait for any in-progress DMA transfer
     if ( ( res = parlio_tx_unit_wait_all_done( cfg->parlio_chan, -1 ) ) != ESP_OK ) {
         log_d( "parlio_strip_free: wait_all_done failed - %s", esp_err_to_name( res ) );
         return res;
@@ -196,11 +564,32 @@ esp_err_t parlio_strip_free( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     }
     cfg->parlio_chan = NULL;
 
+    parlio_tx_detach( &cfg->tx_state, &cfg->parlio_back );
     if ( cfg->parlio_buf ) {
         heap_caps_free( cfg->parlio_buf );
         cfg->parlio_buf       = NULL;
         cfg->parlio_buf_bytes = 0;
     }
+    cfg->stream_chunk = 0;
+    if ( cfg == pio_solo_cfg ) {
+        pio_solo_strip = NULL;
+        pio_solo_cfg   = NULL;
+    }
+    return ESP_OK;
+}
+
+// -------------------------------------------------------------------------
+esp_err_t parlio_strip_free( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    if ( !cfg || ( !cfg->parlio_chan && cfg->share_lane < 0 ) ) {
+        log_d( "parlio_strip_free: called on uninitialized config" );
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t res = ( cfg->share_lane >= 0 ) ? parlio_share_leave( strip, cfg )
+                                             : parlio_strip_release( cfg );
+    if ( res != ESP_OK ) {
+        return res;
+    }
     if ( strip && strip->buf ) {
         free( strip->buf );
         strip->buf = NULL;
@@ -209,41 +598,137 @@ esp_err_t parlio_strip_free( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
 }
 
 // -------------------------------------------------------------------------
-esp_err_t parlio_strip_flush( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+// Internal: encode pixel colour bytes [first, first + count) of a single
+// strip → DMA bytes at out, with brightness scaling.  Runs of identical
+// scaled bytes (typically black) are encoded once and replicated.
+// -------------------------------------------------------------------------
+typedef struct {
+    led_strip_t        *strip;
+    parlio_strip_cfg_t *cfg;
+} parlio_strip_ctx_t;
+
+static void parlio_strip_encode( void *ctx, size_t first, size_t count, uint8_t *out ) {
+    led_strip_t        *strip       = ( ( parlio_strip_ctx_t * )ctx )->strip;
+    parlio_strip_cfg_t *cfg         = ( ( parlio_strip_ctx_t * )ctx )->cfg;
+    const bool          packed      = ( cfg->data_width == 1 );
+    const int           spb         = parlio_led_params[ strip->type ].samples_per_bit;
+    const size_t        block_bytes = parlio_led_byte_bytes( strip->type, cfg->data_width );
+    const uint8_t      *bright_lut  = strip->bright_lut;
+    const uint8_t      *src         = strip->buf + first;
+
+    size_t i = 0;
+    while ( i < count ) {
+        uint8_t val = bright_lut[ src[ i ] ];
+        size_t  run = 1;
+        while ( i + run < count && bright_lut[ src[ i + run ] ] == val ) {
+            run++;
+        }
+        if ( packed ) {
+            parlio_encode_byte_packed( val, cfg->pack_lut, spb, &out[ i * block_bytes ] );
+        }
+        else {
+            parlio_encode_byte( val, cfg->nib_lut, spb, ( uint32_t* )&out[ i * block_bytes ] );
+        }
+        parlio_repeat_block( &out[ i * block_bytes ], block_bytes, run );
+        i += run;
+    }
+}
+
+// -------------------------------------------------------------------------
+// Internal: encode and queue one frame.  Streamed frames are sent in full
+// before this returns; whole frames return as soon as they are queued.
+//
+// A whole-frame buffer keeps its encoded bytes, so only the pixel bytes
+// changed since that buffer was last written are encoded: the strip's
+// dirty range, plus, with two buffers, the range the other buffer took
+// last frame (back_lo / back_hi).
+static esp_err_t parlio_strip_start( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
     if ( !( strip && strip->buf && cfg && cfg->parlio_chan && cfg->parlio_buf ) ) {
         log_d( "parlio_strip_flush: called on uninitialized strip or config" );
         return ESP_ERR_INVALID_ARG;
     }
 
-    const parlio_led_params_t *p     = &parlio_led_params[ strip->type ];
-    const size_t               pixel_bytes = strip->length * PIO_COLOR_SIZE( strip );
-    const uint8_t              brightness  = strip->brightness;
-    uint8_t                   *out         = cfg->parlio_buf;
+    const size_t       pixel_bytes = strip->length * PIO_COLOR_SIZE( strip );
+    const size_t       block_bytes = parlio_led_byte_bytes( strip->type, cfg->data_width );
+    parlio_strip_ctx_t ctx         = { strip, cfg };
+    esp_err_t          res;
 
-    // Encode each pixel colour byte → 3 PARLIO bytes, with brightness scaling.
-    // The reset region (trailing PARLIO_RESET_BYTES bytes = 0x00) is never
-    // written here; it was zeroed by calloc and stays zero across calls.
-    for ( size_t i = 0; i < pixel_bytes; i++ ) {
-        parlio_encode_byte( scale8_video( strip->buf[ i ], brightness ),
-                            p->bit0_pattern, p->bit1_pattern,
-                            &out[ i * p->samples_per_bit * 8 ] );
+    if ( cfg->stream_chunk ) {
+        res = parlio_stream_frame( cfg->parlio_chan, &cfg->tx_state, cfg->parlio_buf,
+                                   cfg->stream_chunk, block_bytes, pixel_bytes,
+                                   parlio_strip_encode, &ctx );
     }
-
-    // Transmit bitstream (pixel data + reset) via DMA.
-    // total_bytes includes PARLIO_RESET_BYTES of trailing zeros.
-    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
-    esp_err_t res = parlio_tx_unit_transmit( cfg->parlio_chan,
-                    cfg->parlio_buf,
-                    cfg->parlio_buf_bytes * 8,
-                    &tx_cfg );
-    if ( res != ESP_OK ) {
+    else {
+        size_t lo = strip->dirty_lo;
+        size_t hi = strip->dirty_hi;
+        if ( cfg->parlio_back ) {
+            lo = ( cfg->back_lo < lo ) ? cfg->back_lo : lo;
+            hi = ( cfg->back_hi > hi ) ? cfg->back_hi : hi;
+            // parlio_buf becomes the back buffer and misses this frame's changes.
+            cfg->back_lo = strip->dirty_lo;
+            cfg->back_hi = strip->dirty_hi;
+        }
+        hi = ( hi > pixel_bytes ) ? pixel_bytes : hi;
+        res = parlio_frame_start( cfg->parlio_chan, &cfg->tx_state,
+                                  &cfg->parlio_buf, &cfg->parlio_back, cfg->parlio_buf_bytes,
+                                  lo, ( lo < hi ) ? hi - lo : 0, block_bytes,
+                                  parlio_strip_encode, &ctx );
+    }
+    if ( res == ESP_OK ) {
+        led_strip_clean( strip );
+    }
+    else {
+        // Which buffer holds what is unknown now: encode everything next time.
+        led_strip_mark_dirty( strip, 0, pixel_bytes );
+        cfg->back_lo = 0;
+        cfg->back_hi = pixel_bytes;
         log_d( "parlio_strip_flush: transmit failed - %s", esp_err_to_name( res ) );
-        return res;
     }
+    return res;
+}
 
-    // Block until the full frame (including the reset period) is done.
-    if ( ( res = parlio_tx_unit_wait_all_done( cfg->parlio_chan, -1 ) ) != ESP_OK ) {
-        log_d( "parlio_strip_flush: wait_all_done failed - %s", esp_err_to_name( res ) );
+// -------------------------------------------------------------------------
+esp_err_t parlio_strip_flush( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    if ( cfg && cfg->share_lane >= 0 ) {
+        // Stage the lane, then send the frame with every lane staged so far.
+        esp_err_t res = parlio_share_stage( strip, cfg );
+        return ( res == ESP_OK ) ? parlio_share_wait( cfg, -1 ) : res;
+    }
+    esp_err_t res = parlio_strip_start( strip, cfg );
+    if ( res == ESP_OK ) {
+        // Block until the frame has left the wire.  The latch time runs from
+        // here and is waited out by the next frame if it has not passed.
+        res = parlio_strip_wait( cfg, -1 );
+    }
+    return res;
+}
+
+// -------------------------------------------------------------------------
+esp_err_t parlio_strip_flush_async( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    if ( cfg && cfg->share_lane >= 0 ) {
+        // The shared frame is sent once the other lanes have been staged.
+        return parlio_share_stage( strip, cfg );
+    }
+    if ( strip && cfg && cfg->parlio_chan && !cfg->parlio_back &&
+            parlio_alloc_back( &cfg->parlio_back, cfg->parlio_buf_bytes, cfg->stream_chunk ) ) {
+        // The new buffer holds no frame yet.
+        cfg->back_lo = 0;
+        cfg->back_hi = strip->length * PIO_COLOR_SIZE( strip );
+    }
+    return parlio_strip_start( strip, cfg );
+}
+
+// -------------------------------------------------------------------------
+esp_err_t parlio_strip_wait( parlio_strip_cfg_t *cfg, int timeout_ms ) {
+    if ( !cfg || !cfg->parlio_chan ) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ( cfg->share_lane >= 0 ) {
+        return parlio_share_wait( cfg, timeout_ms );
+    }
+    esp_err_t res = parlio_tx_unit_wait_all_done( cfg->parlio_chan, timeout_ms );
+    if ( res != ESP_OK && res != ESP_ERR_TIMEOUT ) {
+        log_d( "parlio_strip_wait: wait_all_done failed - %s", esp_err_to_name( res ) );
     }
     return res;
 }
@@ -267,14 +752,22 @@ void parlio_strip_debug_dump( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
         log_printf( "    parlio_chan: %p\n",  cfg->parlio_chan );
         log_printf( "    parlio_buf:  %p (%u bytes)\n",
                     cfg->parlio_buf, cfg->parlio_buf_bytes );
+        log_printf( "    data_width:  %u (%s)\n", cfg->data_width,
+                    cfg->data_width == 1 ? "packed" : "byte per sample" );
+        if ( cfg->share_lane >= 0 ) {
+            log_printf( "    shared TX unit, lane %d\n", cfg->share_lane );
+        }
+        if ( cfg->stream_chunk ) {
+            log_printf( "    streaming:   2 x %u byte chunks (%.2f ms wire time each)\n",
+                        cfg->stream_chunk,
+                        ( float )cfg->stream_chunk * 8.0f / cfg->data_width / ( p->clk_hz / 1e3f ) );
+        }
         log_printf( "parlio_led_params:\n" );
         log_printf( "    clk_hz:          %lu\n",  p->clk_hz );
         log_printf( "    samples_per_bit: %u\n",   p->samples_per_bit );
         log_printf( "    bit0_pattern:    0x%02X\n", p->bit0_pattern );
         log_printf( "    bit1_pattern:    0x%02X\n", p->bit1_pattern );
-        log_printf( "    PARLIO_RESET_BYTES: %u (%.1f us)\n",
-                    PARLIO_RESET_BYTES,
-                    ( float )PARLIO_RESET_BYTES * 8.0f / ( p->clk_hz / 1e6f ) );
+        log_printf( "    reset_us:        %u (idle, not in the DMA buffer)\n", p->reset_us );
         log_printf( "================================================\n" );
         log_printf( "\n" );
     }
@@ -288,99 +781,275 @@ void parlio_strip_debug_dump( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
 // Multi-strip group functions
 // ==========================================================================
 
+// Largest per-lane mask block: 8 x PARLIO_MAX_SAMPLES_PER_BIT samples of the
+// widest TX unit (64 bytes for 16 data lines on the ESP32-P4).
+#define PIO_GROUP_BLOCK_MAX ( PARLIO_MAX_SAMPLES_PER_BIT * ( PARLIO_TX_UNIT_MAX_DATA_WIDTH > 8 ? PARLIO_TX_UNIT_MAX_DATA_WIDTH : 8 ) )
+
 // --------------------------------------------------------------------------
-// parlio_group_install
-//
-// Expects cfg->lanes[n].assigned == true and cfg->lanes[n].strip populated
-// (type, length, is_rgbw, gpio, use_psram) for every registered lane.
-// Allocates per-lane pixel colour buffers and one shared DMA bitstream buffer,
-// then creates and enables the PARLIO TX unit.
+// Internal: smallest legal TX unit width (1, 2, 4, 8 or 16 data lines) that
+// covers the highest lane in the mask.  Lane n is always data line n, so a
+// group using lanes 0..2 runs at width 4 and lane 3 stays unconnected.
 // --------------------------------------------------------------------------
-esp_err_t parlio_group_install( parlio_group_cfg_t *cfg ) {
-    if ( !cfg || cfg->lane_count == 0 ) {
-        log_d( "parlio_group_install: invalid args" );
-        return ESP_ERR_INVALID_ARG;
+static uint8_t parlio_lanes_width( uint32_t lanes ) {
+    uint8_t width = 1;
+    while ( ( lanes >> width ) != 0 && width < PARLIO_TX_UNIT_MAX_DATA_WIDTH ) {
+        width <<= 1;
     }
+    return width;
+}
 
-    // Find first assigned lane to derive shared timing params.
-    uint8_t first = 0;
-    while ( first < PARLIO_TX_UNIT_MAX_DATA_WIDTH && !cfg->lanes[ first ].assigned ) {
-        first++;
-    }
-    if ( first >= PARLIO_TX_UNIT_MAX_DATA_WIDTH ) {
-        log_d( "parlio_group_install: no assigned lanes found" );
-        return ESP_ERR_INVALID_ARG;
+static uint8_t parlio_group_width( const parlio_group_cfg_t *cfg ) {
+    uint32_t lanes = 0;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned ) {
+            lanes |= 1UL << n;
+        }
     }
+    return parlio_lanes_width( lanes );
+}
 
-    const parlio_led_params_t *p          = &parlio_led_params[ cfg->lanes[ first ].strip.type ];
-    const size_t               color_size = 3 + ( cfg->lanes[ first ].strip.is_rgbw ? 1 : 0 );
-    const size_t               length     = cfg->lanes[ first ].strip.length;
-    const size_t               pixel_bytes = length * color_size;
-
-    // Allocate pixel colour buffer for each assigned lane.
+// --------------------------------------------------------------------------
+// Internal: input bytes per frame, set by the longest lane.  Shorter lanes
+// idle low for the rest of it.
+// --------------------------------------------------------------------------
+static size_t parlio_group_frame_bytes( const parlio_group_cfg_t *cfg ) {
+    size_t bytes = 0;
     for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-        if ( !cfg->lanes[ n ].assigned ) {
-            continue;
+        if ( cfg->lanes[ n ].assigned && PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip ) > bytes ) {
+            bytes = PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip );
         }
-        led_strip_t *strip = &cfg->lanes[ n ].strip;
-        if ( strip->use_psram ) {
-            #if CONFIG_SPIRAM
-            if ( psramFound() ) {
-                strip->buf = ( uint8_t * )heap_caps_calloc( length, color_size, MALLOC_CAP_SPIRAM );
-                if ( strip->buf ) {
-                    log_d( "PARLIO group lane %u pixel buffer in PSRAM (%u bytes)", n, pixel_bytes );
+    }
+    return bytes;
+}
+
+// --------------------------------------------------------------------------
+// Internal: build the DMA bytes one input byte produces on lane n.
+//
+// Widths up to 8 pack 8 / W samples into each DMA byte, first sample in the
+// most significant W bits (PARLIO_BIT_PACK_ORDER_MSB).  Width 16 uses one
+// little-endian 16-bit word per sample.  Within a sample, data line n is
+// bit n.  The 8 x samples_per_bit samples of one LED byte therefore fill
+// exactly samples_per_bit * W DMA bytes, which stays byte aligned for every
+// legal W.
+// --------------------------------------------------------------------------
+static void parlio_group_lane_block( const parlio_led_params_t *p, uint8_t val,
+                                     uint8_t n, uint8_t width, uint8_t *block ) {
+    const uint8_t per_byte = ( width < 8 ) ? 8 / width : 1;
+    memset( block, 0, ( size_t )p->samples_per_bit * width );
+    for ( int bit = 0; bit < 8; bit++ ) {
+        uint8_t pat = ( ( val >> ( 7 - bit ) ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+        for ( int s = 0; s < p->samples_per_bit; s++ ) {
+            if ( ( pat >> ( p->samples_per_bit - 1 - s ) ) & 1 ) {
+                size_t t = ( size_t )bit * p->samples_per_bit + s;
+                if ( width == 16 ) {
+                    // 16-bit sample: lanes 0..7 in the low byte, 8..15 in the high byte
+                    block[ t * 2 + ( n >> 3 ) ] |= ( uint8_t )( 1 << ( n & 7 ) );
                 }
-            }
-            #endif
-        }
-        if ( !strip->buf ) {
-            strip->buf = ( uint8_t * )calloc( length, color_size );
-            if ( strip->buf ) {
-                log_d( "PARLIO group lane %u pixel buffer in internal RAM (%u bytes)", n, pixel_bytes );
-            }
-        }
-        if ( !strip->buf ) {
-            log_d( "parlio_group_install: pixel buffer alloc failed for lane %u", n );
-            // Free any already-allocated lane buffers.
-            for ( uint8_t k = 0; k < n; k++ ) {
-                if ( cfg->lanes[ k ].assigned && cfg->lanes[ k ].strip.buf ) {
-                    free( cfg->lanes[ k ].strip.buf );
-                    cfg->lanes[ k ].strip.buf = NULL;
+                else {
+                    uint8_t slot = t % per_byte;
+                    block[ t / per_byte ] |= ( uint8_t )( 1 << ( 8 - width * ( slot + 1 ) + n ) );
                 }
             }
-            return ESP_ERR_NO_MEM;
         }
     }
+}
 
-    // Allocate shared DMA bitstream buffer (always internal DMA-capable RAM).
-    size_t encoded_bytes = pixel_bytes * p->samples_per_bit * 8;
-    size_t total_bytes   = ( encoded_bytes + PARLIO_RESET_BYTES + 3 ) & ~( size_t )3;
+// --------------------------------------------------------------------------
+// Internal: encode pixel bytes [lo, hi) of one lane into frame buf (byte 0
+// of the strip at buf[0]), leaving the other lanes' bits as they are:
+//   dst = ( dst & ~lane_mask ) | lane_block
+// A read-modify-write per DMA byte, so it beats a full column encode only
+// when few lanes changed.
+// --------------------------------------------------------------------------
+static void parlio_lane_patch( const led_strip_t *strip, uint8_t n, uint8_t width,
+                               uint8_t *buf, size_t lo, size_t hi ) {
+    const parlio_led_params_t *p           = &parlio_led_params[ strip->type ];
+    const size_t               block_bytes = parlio_led_byte_bytes( strip->type, width );
+    const uint8_t             *bright_lut  = strip->bright_lut;
 
-    cfg->parlio_buf = ( uint8_t * )heap_caps_calloc( 1, total_bytes,
-                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL );
-    if ( !cfg->parlio_buf ) {
-        log_d( "parlio_group_install: DMA buffer alloc failed (%u bytes)", total_bytes );
-        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-            if ( cfg->lanes[ n ].assigned && cfg->lanes[ n ].strip.buf ) {
-                free( cfg->lanes[ n ].strip.buf );
-                cfg->lanes[ n ].strip.buf = NULL;
-            }
-        }
-        return ESP_ERR_NO_MEM;
+    // keep: every bit of an LED byte's block except lane n's.
+    parlio_led_params_t all = *p;
+    all.bit0_pattern = ( uint8_t )( ( 1 << p->samples_per_bit ) - 1 );
+    uint8_t keep[ PIO_GROUP_BLOCK_MAX ];
+    parlio_group_lane_block( &all, 0, n, width, keep );
+    for ( size_t k = 0; k < block_bytes; k++ ) {
+        keep[ k ] = ( uint8_t )~keep[ k ];
     }
-    cfg->parlio_buf_bytes = total_bytes;
-    log_d( "PARLIO group DMA buffer: %u bytes (%u encoded + %u reset, %u lanes)",
-           total_bytes, encoded_bytes, PARLIO_RESET_BYTES, cfg->lane_count );
 
-    // Create PARLIO TX unit — data_width=8, one GPIO per assigned lane.
-    parlio_tx_unit_config_t chan_cfg = {};
-    chan_cfg.clk_src            = PARLIO_CLK_SRC_DEFAULT;
-    chan_cfg.data_width          = 8;
-    chan_cfg.clk_in_gpio_num     = GPIO_NUM_NC;
-    chan_cfg.clk_out_gpio_num    = GPIO_NUM_NC;
-    chan_cfg.valid_gpio_num      = GPIO_NUM_NC;
-    for ( int i = 0; i < PARLIO_TX_UNIT_MAX_DATA_WIDTH; i++ ) {
-        chan_cfg.data_gpio_nums[ i ] = GPIO_NUM_NC;
+    uint8_t block[ PIO_GROUP_BLOCK_MAX ];
+    int     block_val = -1;
+    for ( size_t b = lo; b < hi; b++ ) {
+        uint8_t val = bright_lut[ strip->buf[ b ] ];
+        if ( val != block_val ) {
+            parlio_group_lane_block( p, val, n, width, block );
+            block_val = val;
+        }
+        uint8_t *dst = &buf[ b * block_bytes ];
+        for ( size_t k = 0; k < block_bytes; k++ ) {
+            dst[ k ] = ( uint8_t )( ( dst[ k ] & keep[ k ] ) | block[ k ] );
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// Internal: allocate one pixel arena for all lanes (obeys the PSRAM
+// preference) and point each lane's strip.buf at its slice.  Slices follow
+// lane order and start word aligned, so each lane is still a plain pixel
+// buffer for ll_strip_pixels, and one allocation replaces one per lane.
+// --------------------------------------------------------------------------
+static esp_err_t parlio_group_alloc_pixels( parlio_group_cfg_t *cfg ) {
+    size_t arena_bytes = 0;
+    bool   use_psram   = false;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned ) {
+            arena_bytes += ( PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip ) + 3 ) & ~( size_t )3;
+            use_psram   |= cfg->lanes[ n ].strip.use_psram;
+        }
+    }
+
+    cfg->pixels = NULL;
+    if ( use_psram ) {
+        #if CONFIG_SPIRAM
+        if ( psramFound() ) {
+            cfg->pixels = ( uint8_t * )heap_caps_calloc( 1, arena_bytes, MALLOC_CAP_SPIRAM );
+            if ( cfg->pixels ) {
+                log_d( "PARLIO group pixel buffers in PSRAM (%u bytes)", arena_bytes );
+            }
+        }
+        #endif
+    }
+    if ( !cfg->pixels ) {
+        cfg->pixels = ( uint8_t * )calloc( 1, arena_bytes );
+        if ( cfg->pixels ) {
+            log_d( "PARLIO group pixel buffers in internal RAM (%u bytes)", arena_bytes );
+        }
+    }
+    if ( !cfg->pixels ) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t offset = 0;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned ) {
+            led_strip_t *strip = &cfg->lanes[ n ].strip;
+            strip->buf = cfg->pixels + offset;
+            offset    += ( PIO_PIXEL_SIZE( strip ) + 3 ) & ~( size_t )3;
+            led_strip_build_bright_lut( strip );
+        }
+    }
+    return ESP_OK;
+}
+
+// --------------------------------------------------------------------------
+// Internal: free what parlio_group_install() allocated besides the TX unit:
+// the DMA buffers, the chunk semaphore and the pixel arena.
+// --------------------------------------------------------------------------
+static void parlio_group_release_buffers( parlio_group_cfg_t *cfg ) {
+    parlio_tx_detach( &cfg->tx_state, &cfg->parlio_back );
+    if ( cfg->parlio_buf ) {
+        heap_caps_free( cfg->parlio_buf );
+        cfg->parlio_buf       = NULL;
+        cfg->parlio_buf_bytes = 0;
+    }
+    if ( cfg->pixels ) {
+        free( cfg->pixels );
+        cfg->pixels = NULL;
+    }
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        cfg->lanes[ n ].strip.buf = NULL;
+    }
+}
+
+// --------------------------------------------------------------------------
+// parlio_group_install
+//
+// Expects cfg->lanes[n].assigned == true and cfg->lanes[n].strip populated
+// (type, length, is_rgbw, gpio, use_psram) for every registered lane.  Lanes
+// may differ in length, RGBW and LED type, as long as the types share clock
+// and samples per bit (parlio_led_fits()).  Allocates one pixel arena
+// holding every lane's colour buffer and one shared DMA bitstream buffer
+// sized for the longest lane, then creates and enables the PARLIO TX unit.
+// --------------------------------------------------------------------------
+esp_err_t parlio_group_install( parlio_group_cfg_t *cfg ) {
+    if ( !cfg || cfg->lane_count == 0 ) {
+        log_d( "parlio_group_install: invalid args" );
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Find first assigned lane to derive shared timing params.
+    uint8_t first = 0;
+    while ( first < PARLIO_TX_UNIT_MAX_DATA_WIDTH && !cfg->lanes[ first ].assigned ) {
+        first++;
+    }
+    if ( first >= PARLIO_TX_UNIT_MAX_DATA_WIDTH ) {
+        log_d( "parlio_group_install: no assigned lanes found" );
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The lanes share the first lane's clock and samples per bit.
+    const parlio_led_params_t *p = &parlio_led_params[ cfg->lanes[ first ].strip.type ];
+    for ( uint8_t n = first + 1; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned && !parlio_led_fits( cfg->lanes[ first ].strip.type, cfg->lanes[ n ].strip.type ) ) {
+            log_d( "parlio_group_install: lane %u LED type %u cannot share the PARLIO clock of lane %u",
+                   n, cfg->lanes[ n ].strip.type, first );
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    }
+    const size_t pixel_bytes = parlio_group_frame_bytes( cfg );
+
+    if ( parlio_group_alloc_pixels( cfg ) != ESP_OK ) {
+        log_d( "parlio_group_install: pixel buffer alloc failed" );
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Allocate shared DMA bitstream buffer (always internal DMA-capable RAM).
+    // Each input byte of the longest lane is 8 x samples_per_bit samples of
+    // data_width bits (parlio_led_byte_bytes()); the reset is idle time after
+    // the transfer and takes no DMA bytes.
+    cfg->data_width      = parlio_group_width( cfg );
+    size_t encoded_bytes = pixel_bytes * parlio_led_byte_bytes( cfg->lanes[ first ].strip.type, cfg->data_width );
+    size_t total_bytes   = ( encoded_bytes + 3 ) & ~( size_t )3;
+
+    // Latch time: the longest any lane's LED type needs.
+    uint16_t reset_us = 0;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned && parlio_led_params[ cfg->lanes[ n ].strip.type ].reset_us > reset_us ) {
+            reset_us = parlio_led_params[ cfg->lanes[ n ].strip.type ].reset_us;
+        }
+    }
+
+    // Long strips or wide groups stream through two chunks instead.
+    cfg->stream_chunk = parlio_stream_chunk_bytes( total_bytes,
+                        parlio_led_byte_bytes( cfg->lanes[ first ].strip.type, cfg->data_width ) );
+    cfg->parlio_back  = NULL;
+    size_t buf_bytes  = cfg->stream_chunk ? cfg->stream_chunk * 2 : total_bytes;
+
+    cfg->parlio_buf = ( uint8_t * )heap_caps_calloc( 1, buf_bytes,
+                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL );
+    if ( !cfg->parlio_buf ) {
+        log_d( "parlio_group_install: DMA buffer alloc failed (%u bytes)", buf_bytes );
+        parlio_group_release_buffers( cfg );
+        return ESP_ERR_NO_MEM;
+    }
+    cfg->parlio_buf_bytes = buf_bytes;
+    if ( cfg->stream_chunk ) {
+        log_d( "PARLIO group DMA buffer: 2 x %u byte stream chunks for a %u byte frame (%u lanes, data_width %u)",
+               cfg->stream_chunk, total_bytes, cfg->lane_count, cfg->data_width );
+    }
+    else {
+        log_d( "PARLIO group DMA buffer: %u bytes (%u encoded, %u lanes, data_width %u)",
+               total_bytes, encoded_bytes, cfg->lane_count, cfg->data_width );
+    }
+
+    // Create PARLIO TX unit — one GPIO per assigned lane.
+    parlio_tx_unit_config_t chan_cfg = {};
+    chan_cfg.clk_src            = PARLIO_CLK_SRC_DEFAULT;
+    chan_cfg.data_width          = cfg->data_width;
+    chan_cfg.clk_in_gpio_num     = GPIO_NUM_NC;
+    chan_cfg.clk_out_gpio_num    = GPIO_NUM_NC;
+    chan_cfg.valid_gpio_num      = GPIO_NUM_NC;
+    for ( int i = 0; i < PARLIO_TX_UNIT_MAX_DATA_WIDTH; i++ ) {
+        chan_cfg.data_gpio_nums[ i ] = GPIO_NUM_NC;
     }
     for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
         if ( cfg->lanes[ n ].assigned ) {
@@ -388,36 +1057,25 @@ esp_err_t parlio_group_install( parlio_group_cfg_t *cfg ) {
         }
     }
     chan_cfg.output_clk_freq_hz  = p->clk_hz;
-    chan_cfg.trans_queue_depth   = 4;
-    chan_cfg.max_transfer_size   = total_bytes;
+    chan_cfg.trans_queue_depth   = PIO_TRANS_QUEUE_DEPTH;
+    chan_cfg.max_transfer_size   = cfg->stream_chunk ? cfg->stream_chunk : total_bytes;
+    chan_cfg.bit_pack_order      = PARLIO_BIT_PACK_ORDER_MSB;  // first sample in the high bits
     chan_cfg.flags.clk_gate_en   = false;
 
     esp_err_t res = parlio_new_tx_unit( &chan_cfg, &cfg->parlio_chan );
     if ( res != ESP_OK ) {
         log_d( "parlio_group_install: parlio_new_tx_unit failed - %s", esp_err_to_name( res ) );
-        heap_caps_free( cfg->parlio_buf );
-        cfg->parlio_buf = NULL;
-        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-            if ( cfg->lanes[ n ].assigned && cfg->lanes[ n ].strip.buf ) {
-                free( cfg->lanes[ n ].strip.buf );
-                cfg->lanes[ n ].strip.buf = NULL;
-            }
-        }
+        parlio_group_release_buffers( cfg );
         return res;
     }
 
-    if ( ( res = parlio_tx_unit_enable( cfg->parlio_chan ) ) != ESP_OK ) {
-        log_d( "parlio_group_install: parlio_tx_unit_enable failed - %s", esp_err_to_name( res ) );
+    if ( ( res = parlio_tx_attach( cfg->parlio_chan, &cfg->tx_state,
+                                   cfg->stream_chunk != 0, reset_us ) ) != ESP_OK ||
+            ( res = parlio_tx_unit_enable( cfg->parlio_chan ) ) != ESP_OK ) {
+        log_d( "parlio_group_install: TX unit callbacks / enable failed - %s", esp_err_to_name( res ) );
         parlio_del_tx_unit( cfg->parlio_chan );
         cfg->parlio_chan = NULL;
-        heap_caps_free( cfg->parlio_buf );
-        cfg->parlio_buf = NULL;
-        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-            if ( cfg->lanes[ n ].assigned && cfg->lanes[ n ].strip.buf ) {
-                free( cfg->lanes[ n ].strip.buf );
-                cfg->lanes[ n ].strip.buf = NULL;
-            }
-        }
+        parlio_group_release_buffers( cfg );
         return res;
     }
 
@@ -427,75 +1085,404 @@ esp_err_t parlio_group_install( parlio_group_cfg_t *cfg ) {
 }
 
 // --------------------------------------------------------------------------
-// parlio_group_flush
+// Internal: 8 x 8 bit-matrix transpose.  Row n of the matrix is rows[n];
+// plane j of the result holds bit (7 - j) of every row, row n in bit n, so
+// plane 0 is the MSB of all eight lanes.  Three delta swaps on one 64-bit
+// word (Hacker's Delight, transpose8).
+// --------------------------------------------------------------------------
+static inline void parlio_transpose8( const uint8_t rows[ 8 ], uint8_t planes[ 8 ] ) {
+    uint64_t x = 0;
+    for ( int n = 7; n >= 0; n-- ) {
+        x = ( x << 8 ) | rows[ n ];
+    }
+    uint64_t t;
+    t = ( x ^ ( x >> 7 ) )  & 0x00AA00AA00AA00AAULL;  x ^= t ^ ( t << 7 );
+    t = ( x ^ ( x >> 14 ) ) & 0x0000CCCC0000CCCCULL;  x ^= t ^ ( t << 14 );
+    t = ( x ^ ( x >> 28 ) ) & 0x00000000F0F0F0F0ULL;  x ^= t ^ ( t << 28 );
+    // Byte c of x now holds bit c of every row.
+    for ( int j = 0; j < 8; j++ ) {
+        planes[ j ] = ( uint8_t )( x >> ( 8 * ( 7 - j ) ) );
+    }
+}
+
+// --------------------------------------------------------------------------
+// Internal: encode input bytes [first, first + count) of every lane into out.
+//
+// Each input byte position is one column across the lanes: the lanes'
+// brightness-scaled bytes are transposed into 8 bit-planes (one per LED
+// bit, lane N in bit N, 16-bit planes for 16 lanes), and each plane gives
+// samples_per_bit samples directly:
 //
-// Zeros the shared DMA buffer, then for each assigned lane ORs that lane's
-// waveform bits (with brightness applied) into the appropriate bit position
-// of each DMA byte.  After all lanes are encoded, transmits and blocks.
+//   sample s of a bit = ( plane & high_if_1[ s ] ) | ( ~plane & high_if_0[ s ] )
 //
-// Encoding layout (per input byte b, bit j MSB-first, sample s in 0..2):
-//   DMA byte index = b * (samples_per_bit * 8) + (7 - j) * samples_per_bit + s
-//   bit N of that byte = lane N's waveform sample value at that time slot
+// where high_if_1 / high_if_0 hold the lanes whose LED type's bit1 / bit0
+// pattern is high in sample s.  Lanes past their last byte are masked out
+// and stay low.  Every DMA byte is written exactly once, so the buffer needs
+// no clearing.
+//
+// Encoding layout (per input byte b, bit j MSB-first, sample s,
+// W = cfg->data_width, t = j * samples_per_bit + s):
+//   DMA byte index = b * (samples_per_bit * W) + t / (8 / W)
+//   bit (8 - W * (t % (8 / W) + 1) + N) of that byte = lane N's sample
+// With W = 8 this is one DMA byte per sample and bit N = lane N; with
+// W = 16 each sample is a little-endian uint16_t and bit N = lane N.
+// Columns equal to the previous one (black in sparse effects) are copied.
 // --------------------------------------------------------------------------
-esp_err_t parlio_group_flush( parlio_group_cfg_t *cfg ) {
-    if ( !cfg || !cfg->parlio_chan || !cfg->parlio_buf || cfg->lane_count == 0 ) {
-        log_d( "parlio_group_flush: invalid args" );
-        return ESP_ERR_INVALID_ARG;
-    }
+static void parlio_group_encode( void *ctx, size_t first, size_t count, uint8_t *out ) {
+    parlio_group_cfg_t *cfg = ( parlio_group_cfg_t * )ctx;
 
     // Find first assigned lane for shared params.
+    uint8_t lead = 0;
+    while ( lead < PARLIO_TX_UNIT_MAX_DATA_WIDTH && !cfg->lanes[ lead ].assigned ) {
+        lead++;
+    }
+
+    const int                  spb         = parlio_led_params[ cfg->lanes[ lead ].strip.type ].samples_per_bit;
+    const uint8_t              width       = cfg->data_width;
+    const size_t               block_bytes = parlio_led_byte_bytes( cfg->lanes[ lead ].strip.type, width );
+    const uint8_t              columns     = ( width > 8 ) ? 2 : 1;   // 8-lane transposes per column
+
+    // Sample masks: the lanes that are high in sample s of a 1 / 0 bit, and
+    // each lane's length in input bytes (0 for unused lanes).
+    uint16_t high_if_1[ PARLIO_MAX_SAMPLES_PER_BIT ] = { 0 };
+    uint16_t high_if_0[ PARLIO_MAX_SAMPLES_PER_BIT ] = { 0 };
+    size_t   lane_bytes[ 16 ] = { 0 };
+    for ( uint8_t n = 0; n < width; n++ ) {
+        if ( !cfg->lanes[ n ].assigned ) {
+            continue;
+        }
+        const parlio_led_params_t *p = &parlio_led_params[ cfg->lanes[ n ].strip.type ];
+        for ( int s = 0; s < spb; s++ ) {
+            if ( ( p->bit1_pattern >> ( spb - 1 - s ) ) & 1 ) {
+                high_if_1[ s ] |= ( uint16_t )( 1 << n );
+            }
+            if ( ( p->bit0_pattern >> ( spb - 1 - s ) ) & 1 ) {
+                high_if_0[ s ] |= ( uint16_t )( 1 << n );
+            }
+        }
+        lane_bytes[ n ] = PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip );
+    }
+
+    uint8_t  col[ 16 ] = { 0 };     // this input byte of every lane (0 past a lane's end)
+    size_t   b = 0;
+    while ( b < count ) {
+        uint16_t live = 0;          // lanes that still have data in this column
+        for ( uint8_t n = 0; n < width; n++ ) {
+            if ( first + b < lane_bytes[ n ] ) {
+                col[ n ] = cfg->lanes[ n ].strip.bright_lut[ cfg->lanes[ n ].strip.buf[ first + b ] ];
+                live    |= ( uint16_t )( 1 << n );
+            }
+            else {
+                col[ n ] = 0;
+            }
+        }
+        uint8_t planes[ 2 ][ 8 ];
+        parlio_transpose8( col, planes[ 0 ] );
+        if ( columns == 2 ) {
+            parlio_transpose8( col + 8, planes[ 1 ] );
+        }
+
+        uint8_t *dst = &out[ b * block_bytes ];
+        uint8_t  acc = 0;
+        uint8_t  bits = 0;
+        for ( int j = 0; j < 8; j++ ) {
+            uint16_t plane = planes[ 0 ][ j ];
+            if ( columns == 2 ) {
+                plane |= ( uint16_t )( planes[ 1 ][ j ] << 8 );
+            }
+            for ( int s = 0; s < spb; s++ ) {
+                uint16_t sample = ( uint16_t )( ( ( plane & high_if_1[ s ] ) | ( ~plane & high_if_0[ s ] ) ) & live );
+                if ( width == 16 ) {
+                    *dst++ = ( uint8_t )sample;
+                    *dst++ = ( uint8_t )( sample >> 8 );
+                }
+                else if ( width == 8 ) {
+                    *dst++ = ( uint8_t )sample;
+                }
+                else {
+                    // First sample in the most significant W bits of each byte.
+                    acc   = ( uint8_t )( ( acc << width ) | sample );
+                    bits += width;
+                    if ( bits == 8 ) {
+                        *dst++ = acc;
+                        bits   = 0;
+                    }
+                }
+            }
+        }
+
+        // Following columns with the same bytes on the same live lanes repeat
+        // this block.
+        size_t run = 1;
+        while ( b + run < count ) {
+            bool same = true;
+            for ( uint8_t n = 0; n < width && same; n++ ) {
+                if ( first + b + run < lane_bytes[ n ] ) {
+                    same = ( ( live >> n ) & 1 ) &&
+                           cfg->lanes[ n ].strip.bright_lut[ cfg->lanes[ n ].strip.buf[ first + b + run ] ] == col[ n ];
+                }
+                else {
+                    same = !( ( live >> n ) & 1 );
+                }
+            }
+            if ( !same ) {
+                break;
+            }
+            run++;
+        }
+        parlio_repeat_block( &out[ b * block_bytes ], block_bytes, run );
+        b += run;
+    }
+}
+
+// --------------------------------------------------------------------------
+// Internal: bring a whole-frame group buffer up to date.  Each lane's
+// range [lo[n], hi[n]) lists the pixel bytes the buffer lacks.  When the
+// ranges do not overlap (typically one lane changed) each lane's bits are
+// patched on their own, and the other lanes are not touched.  Otherwise
+// the union of the ranges is encoded column by column for all lanes.
+// --------------------------------------------------------------------------
+typedef struct {
+    parlio_group_cfg_t *cfg;
+    size_t              lo[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];
+    size_t              hi[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];
+    bool                patch;
+} parlio_group_update_t;
+
+static void parlio_group_update( void *ctx, size_t first, size_t count, uint8_t *out ) {
+    parlio_group_update_t *u   = ( parlio_group_update_t * )ctx;
+    parlio_group_cfg_t    *cfg = u->cfg;
+    if ( !u->patch ) {
+        parlio_group_encode( cfg, first, count, out );
+        return;
+    }
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned && u->lo[ n ] < u->hi[ n ] ) {
+            const size_t block_bytes = parlio_led_byte_bytes( cfg->lanes[ n ].strip.type, cfg->data_width );
+            parlio_lane_patch( &cfg->lanes[ n ].strip, n, cfg->data_width,
+                               out - first * block_bytes, u->lo[ n ], u->hi[ n ] );
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// parlio_group_start (internal) / parlio_group_flush / parlio_group_flush_async
+//
+// Encodes the lanes into the shared DMA buffer, or streams them through its
+// two chunks, and transmits.  flush then blocks until the frame is done;
+// flush_async returns once it is queued.
+//
+// A whole-frame buffer keeps its encoded bytes, so only what changed since
+// it was last written is encoded: each lane's dirty range, plus, with two
+// buffers, the range the other buffer took last frame (lanes[n].back_lo /
+// back_hi).  Lanes that did not change cost nothing.
+//
+// Whole frames go through parlio_group_prepare() (encode, unit idle),
+// parlio_frame_send() and parlio_group_settle() (dirty ranges), so the
+// synchronized flush below can run the three steps across groups.
+// --------------------------------------------------------------------------
+static bool parlio_group_ready( const parlio_group_cfg_t *cfg ) {
+    return cfg && cfg->parlio_chan && cfg->parlio_buf && cfg->lane_count != 0;
+}
+
+static size_t parlio_group_block_bytes( const parlio_group_cfg_t *cfg ) {
     uint8_t first = 0;
     while ( first < PARLIO_TX_UNIT_MAX_DATA_WIDTH && !cfg->lanes[ first ].assigned ) {
         first++;
     }
+    return parlio_led_byte_bytes( cfg->lanes[ first ].strip.type, cfg->data_width );
+}
 
-    const parlio_led_params_t *p          = &parlio_led_params[ cfg->lanes[ first ].strip.type ];
-    const size_t               color_size = 3 + ( cfg->lanes[ first ].strip.is_rgbw ? 1 : 0 );
-    const size_t               pixel_bytes = cfg->lanes[ first ].strip.length * color_size;
-    const size_t               spb         = p->samples_per_bit;  // 3
-
-    // Zero entire DMA buffer.  The encoded region gets |= filled per lane;
-    // the reset tail (trailing PARLIO_RESET_BYTES) stays zero.
-    memset( cfg->parlio_buf, 0, cfg->parlio_buf_bytes );
+// Whole-frame groups: bring parlio_buf up to date, leaving the unit idle.
+static esp_err_t parlio_group_prepare( parlio_group_cfg_t *cfg ) {
+    parlio_group_update_t u;
+    size_t lo  = parlio_group_frame_bytes( cfg );
+    size_t hi  = 0;
+    size_t sum = 0;
+    u.cfg = cfg;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( !cfg->lanes[ n ].assigned ) {
+            continue;
+        }
+        parlio_lane_t *lane = &cfg->lanes[ n ];
+        size_t l = lane->strip.dirty_lo;
+        size_t h = lane->strip.dirty_hi;
+        if ( cfg->parlio_back ) {
+            l = ( lane->back_lo < l ) ? lane->back_lo : l;
+            h = ( lane->back_hi > h ) ? lane->back_hi : h;
+            // parlio_buf becomes the back buffer and misses this frame's changes.
+            lane->back_lo = lane->strip.dirty_lo;
+            lane->back_hi = lane->strip.dirty_hi;
+        }
+        h = ( h > PIO_PIXEL_SIZE( &lane->strip ) ) ? PIO_PIXEL_SIZE( &lane->strip ) : h;
+        u.lo[ n ] = l;
+        u.hi[ n ] = h;
+        if ( l < h ) {
+            lo   = ( l < lo ) ? l : lo;
+            hi   = ( h > hi ) ? h : hi;
+            sum += h - l;
+        }
+    }
+    u.patch = ( lo < hi ) && ( sum <= hi - lo );
+    return parlio_frame_prepare( cfg->parlio_chan, &cfg->parlio_buf, &cfg->parlio_back,
+                                 lo, ( lo < hi ) ? hi - lo : 0, parlio_group_block_bytes( cfg ),
+                                 parlio_group_update, &u );
+}
 
-    // Encode each lane into its bit position.
+// Record the outcome of a frame in the lanes' dirty ranges.
+static void parlio_group_settle( parlio_group_cfg_t *cfg, esp_err_t res ) {
     for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
         if ( !cfg->lanes[ n ].assigned ) {
             continue;
         }
-        led_strip_t *strip  = &cfg->lanes[ n ].strip;
-        uint8_t      bright = strip->brightness;
-
-        for ( size_t b = 0; b < pixel_bytes; b++ ) {
-            uint8_t val = scale8_video( strip->buf[ b ], bright );
-            // Expand all 8 bits of val, MSB first.
-            for ( int bit = 7; bit >= 0; bit-- ) {
-                uint8_t pat    = ( ( val >> bit ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
-                // DMA byte index for the first sample of this bit slot.
-                size_t  offset = b * spb * 8 + ( size_t )( 7 - bit ) * spb;
-                cfg->parlio_buf[ offset + 0 ] |= ( uint8_t )( ( ( pat >> 2 ) & 1 ) << n );
-                cfg->parlio_buf[ offset + 1 ] |= ( uint8_t )( ( ( pat >> 1 ) & 1 ) << n );
-                cfg->parlio_buf[ offset + 2 ] |= ( uint8_t )( (   pat        & 1 ) << n );
+        if ( res == ESP_OK ) {
+            led_strip_clean( &cfg->lanes[ n ].strip );
+        }
+        else {
+            // Which buffer holds what is unknown now: encode everything next time.
+            led_strip_mark_dirty( &cfg->lanes[ n ].strip, 0, PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip ) );
+            cfg->lanes[ n ].back_lo = 0;
+            cfg->lanes[ n ].back_hi = PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip );
+        }
+    }
+    if ( res != ESP_OK ) {
+        log_d( "parlio_group_flush: transmit failed - %s", esp_err_to_name( res ) );
+    }
+}
+
+static esp_err_t parlio_group_start( parlio_group_cfg_t *cfg ) {
+    if ( !parlio_group_ready( cfg ) ) {
+        log_d( "parlio_group_flush: invalid args" );
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t res;
+    if ( cfg->stream_chunk ) {
+        res = parlio_stream_frame( cfg->parlio_chan, &cfg->tx_state, cfg->parlio_buf,
+                                   cfg->stream_chunk, parlio_group_block_bytes( cfg ),
+                                   parlio_group_frame_bytes( cfg ), parlio_group_encode, cfg );
+    }
+    else if ( ( res = parlio_group_prepare( cfg ) ) == ESP_OK ) {
+        res = parlio_frame_send( cfg->parlio_chan, &cfg->tx_state, cfg->parlio_buf, cfg->parlio_buf_bytes );
+    }
+    parlio_group_settle( cfg, res );
+    return res;
+}
+
+// Add the second frame buffer on the first showAsync().
+static void parlio_group_alloc_back( parlio_group_cfg_t *cfg ) {
+    if ( cfg && cfg->parlio_chan && !cfg->parlio_back &&
+            parlio_alloc_back( &cfg->parlio_back, cfg->parlio_buf_bytes, cfg->stream_chunk ) ) {
+        // The new buffer holds no frame yet.
+        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+            cfg->lanes[ n ].back_lo = 0;
+            cfg->lanes[ n ].back_hi = PIO_PIXEL_SIZE( &cfg->lanes[ n ].strip );
+        }
+    }
+}
+
+esp_err_t parlio_group_flush( parlio_group_cfg_t *cfg ) {
+    esp_err_t res = parlio_group_start( cfg );
+    if ( res == ESP_OK ) {
+        res = parlio_group_wait( cfg, -1 );
+    }
+    return res;
+}
+
+esp_err_t parlio_group_flush_async( parlio_group_cfg_t *cfg ) {
+    parlio_group_alloc_back( cfg );
+    return parlio_group_start( cfg );
+}
+
+esp_err_t parlio_group_wait( parlio_group_cfg_t *cfg, int timeout_ms ) {
+    if ( !cfg || !cfg->parlio_chan ) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t res = parlio_tx_unit_wait_all_done( cfg->parlio_chan, timeout_ms );
+    if ( res != ESP_OK && res != ESP_ERR_TIMEOUT ) {
+        log_d( "parlio_group_wait: wait_all_done failed - %s", esp_err_to_name( res ) );
+    }
+    return res;
+}
+
+// --------------------------------------------------------------------------
+// parlio_groups_flush / parlio_groups_flush_async
+//
+// Several groups, one frame.  Every group is first encoded and its unit
+// left idle; the reset gaps are then waited out together and the transfers
+// queued back to back, so the groups start within one
+// parlio_tx_unit_transmit() call of each other.  A preemption in between
+// only lengthens the LOW gap of the groups not yet queued.  Streamed groups
+// cannot be held back while the others are queued and are refused.
+// --------------------------------------------------------------------------
+#if LL_PARLIO_TX_UNITS > 1
+static esp_err_t parlio_groups_start( parlio_group_cfg_t *const cfgs[], uint8_t count ) {
+    if ( !cfgs || count == 0 || count > LL_PARLIO_TX_UNITS ) {
+        log_d( "parlio_groups_flush: invalid args" );
+        return ESP_ERR_INVALID_ARG;
+    }
+    for ( uint8_t k = 0; k < count; k++ ) {
+        if ( !parlio_group_ready( cfgs[ k ] ) ) {
+            log_d( "parlio_groups_flush: group %u not installed", k );
+            return ESP_ERR_INVALID_ARG;
+        }
+        if ( cfgs[ k ]->stream_chunk ) {
+            log_d( "parlio_groups_flush: group %u is streamed", k );
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        for ( uint8_t j = 0; j < k; j++ ) {
+            if ( cfgs[ j ] == cfgs[ k ] ) {
+                log_d( "parlio_groups_flush: group %u listed twice", k );
+                return ESP_ERR_INVALID_ARG;
             }
         }
     }
 
-    // Transmit — buf_bytes * 8 because the IDF API counts in bits.
-    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
-    esp_err_t res = parlio_tx_unit_transmit( cfg->parlio_chan,
-                    cfg->parlio_buf,
-                    cfg->parlio_buf_bytes * 8,
-                    &tx_cfg );
+    esp_err_t res = ESP_OK;
+    for ( uint8_t k = 0; k < count && res == ESP_OK; k++ ) {
+        res = parlio_group_prepare( cfgs[ k ] );
+    }
     if ( res != ESP_OK ) {
-        log_d( "parlio_group_flush: transmit failed - %s", esp_err_to_name( res ) );
+        for ( uint8_t k = 0; k < count; k++ ) {
+            parlio_group_settle( cfgs[ k ], res );
+        }
         return res;
     }
-    if ( ( res = parlio_tx_unit_wait_all_done( cfg->parlio_chan, -1 ) ) != ESP_OK ) {
-        log_d( "parlio_group_flush: wait_all_done failed - %s", esp_err_to_name( res ) );
+
+    esp_err_t sent[ LL_PARLIO_TX_UNITS ];
+    for ( uint8_t k = 0; k < count; k++ ) {
+        parlio_reset_gap( &cfgs[ k ]->tx_state );
+    }
+    for ( uint8_t k = 0; k < count; k++ ) {
+        sent[ k ] = parlio_frame_send( cfgs[ k ]->parlio_chan, &cfgs[ k ]->tx_state,
+                                       cfgs[ k ]->parlio_buf, cfgs[ k ]->parlio_buf_bytes );
+    }
+
+    for ( uint8_t k = 0; k < count; k++ ) {
+        parlio_group_settle( cfgs[ k ], sent[ k ] );
+        if ( sent[ k ] != ESP_OK && res == ESP_OK ) {
+            res = sent[ k ];
+        }
+    }
+    return res;
+}
+
+esp_err_t parlio_groups_flush( parlio_group_cfg_t *const cfgs[], uint8_t count ) {
+    esp_err_t res = parlio_groups_start( cfgs, count );
+    for ( uint8_t k = 0; k < count && res == ESP_OK; k++ ) {
+        res = parlio_group_wait( cfgs[ k ], -1 );
     }
     return res;
 }
 
+esp_err_t parlio_groups_flush_async( parlio_group_cfg_t *const cfgs[], uint8_t count ) {
+    for ( uint8_t k = 0; cfgs && k < count && k < LL_PARLIO_TX_UNITS; k++ ) {
+        parlio_group_alloc_back( cfgs[ k ] );
+    }
+    return parlio_groups_start( cfgs, count );
+}
+#endif /* LL_PARLIO_TX_UNITS > 1 */
+
 // --------------------------------------------------------------------------
 // parlio_group_free
 // --------------------------------------------------------------------------
@@ -520,20 +1507,509 @@ esp_err_t parlio_group_free( parlio_group_cfg_t *cfg ) {
     }
     cfg->parlio_chan = NULL;
 
-    if ( cfg->parlio_buf ) {
-        heap_caps_free( cfg->parlio_buf );
-        cfg->parlio_buf       = NULL;
-        cfg->parlio_buf_bytes = 0;
+    parlio_group_release_buffers( cfg );
+    return ESP_OK;
+}
+
+// ==========================================================================
+// Shared TX unit — LiteLEDpio instances as lanes of one unit
+//
+// Chips with a single PARLIO TX unit can still run several LiteLEDpio
+// instances: the first one owns the unit as usual, and when another finds
+// no unit free, both move onto this shared unit as lanes, like a
+// LiteLEDpioGroup built behind the scenes.  Each later instance adds a
+// lane; the unit is rebuilt whenever lanes join or leave and deleted with
+// the last one.
+//
+// The shared frame is as long as the longest lane.  A shorter lane's line
+// stays LOW after its last LED byte, which its strip takes as the reset.
+// Each show() re-encodes only its own lane's dirty bytes, so the other
+// lanes keep the frame they last showed.  showAsync() only stages its lane:
+// the frame goes out once every lane has been staged, so a loop calling
+// showAsync() on each strip costs one transfer per pass instead of one per
+// strip.  Lanes that stop calling it do not hold the others back: the frame
+// is also sent LL_PARLIO_SHARE_WINDOW_US after the first lane of a pass was
+// staged, when a lane is staged a second time, or when one waits for its
+// frame.  show() stages its lane and then waits for the frame, like a
+// showAsync() followed by waitShow(), so blocking show() calls are never
+// merged: a loop of them sends one frame per strip, each as long as the
+// longest lane.
+//
+// No one waits on the TX unit while holding the lock, as the unit may be
+// rebuilt meanwhile and the window timer needs the lock.  Waiters block on
+// the sent semaphore instead, which parlio_share_sent() gives once for each
+// of them whenever a frame leaves the wire.
+// ==========================================================================
+
+typedef struct {
+    parlio_tx_unit_handle_t  chan;                                       /* shared PARLIO TX unit */
+    uint8_t                 *buf;                                        /* shared frame, all lanes interleaved */
+    size_t                   buf_bytes;                                  /* size of the frame in bytes */
+    size_t                   buf_cap;                                    /* allocated size of buf, >= buf_bytes */
+    uint8_t                  data_width;                                 /* TX unit width: 1, 2, 4, 8 or 16 lines */
+    uint8_t                  lane_count;                                 /* number of lanes */
+    uint32_t                 lanes;                                      /* mask of assigned lanes */
+    uint32_t                 staged;                                     /* lanes encoded since buf was last sent */
+    volatile uint32_t        sending;                                    /* lanes in the frame on the wire */
+    led_strip_t             *strips[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];    /* each lane's strip */
+    parlio_strip_cfg_t      *cfgs[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];      /* each lane's config (busy flag, callback) */
+    SemaphoreHandle_t        lock;                                       /* serialises show(), the window timer and rebuilds */
+    SemaphoreHandle_t        sent;                                       /* given once per waiter when a frame has been sent */
+    volatile uint8_t         waiters;                                    /* tasks blocked on sent */
+    esp_timer_handle_t       window;                                     /* sends a partly staged frame */
+    parlio_tx_state_t        tx_state;                                   /* TX done state shared with the ISR */
+} parlio_share_t;
+
+static parlio_share_t pio_share;
+
+// Runs from the TX done ISR (as tx_state.done_cb): the lanes in the frame
+// that just left the wire are no longer busy.  A waiter woken here is
+// reported through tx_state.woken, which parlio_tx_done() returns.
+static IRAM_ATTR void parlio_share_sent( void *arg ) {
+    parlio_share_t *sh    = ( parlio_share_t * )arg;
+    uint32_t        sent  = sh->sending;
+    BaseType_t      woken = pdFALSE;
+    sh->sending = 0;
+    for ( uint8_t n = 0; sent; n++, sent >>= 1 ) {
+        if ( ( sent & 1 ) && sh->cfgs[ n ] ) {
+            parlio_tx_state_t *st = &sh->cfgs[ n ]->tx_state;
+            st->tx_busy = 0;
+            ll_show_done_cb_t cb = st->done_cb;
+            if ( cb ) {
+                cb( st->done_arg );
+            }
+        }
+    }
+    for ( uint8_t w = sh->waiters; w; w-- ) {
+        xSemaphoreGiveFromISR( sh->sent, &woken );
+    }
+    sh->tx_state.woken = woken;
+}
+
+// Wait up to ticks for *busy to clear.  Called and returns with the lock
+// held, but releases it while blocked, so the shared unit may have been
+// rebuilt (or lost) by the time this returns.
+static esp_err_t parlio_share_block( volatile uint8_t *busy, TickType_t ticks ) {
+    const TickType_t start = xTaskGetTickCount();
+    for ( ;; ) {
+        // Counted before busy is read, so a frame sent in between still
+        // gives the semaphore for us.  An extra give only costs a loop.
+        pio_share.waiters++;
+        const TickType_t waited = xTaskGetTickCount() - start;
+        if ( !*busy || ( ticks != portMAX_DELAY && waited >= ticks ) ) {
+            pio_share.waiters--;
+            return *busy ? ESP_ERR_TIMEOUT : ESP_OK;
+        }
+        xSemaphoreGive( pio_share.lock );
+        xSemaphoreTake( pio_share.sent, ( ticks == portMAX_DELAY ) ? portMAX_DELAY : ticks - waited );
+        xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+        pio_share.waiters--;
+    }
+}
+
+// Encode pixel bytes [lo, hi) of lane n into the shared frame.
+static void parlio_share_encode( uint8_t n, size_t lo, size_t hi ) {
+    parlio_lane_patch( pio_share.strips[ n ], n, pio_share.data_width, pio_share.buf, lo, hi );
+}
+
+// Queue the shared frame.  Called with the lock held while no transfer is
+// in flight.
+static esp_err_t parlio_share_send( void ) {
+    esp_timer_stop( pio_share.window );
+    parlio_reset_gap( &pio_share.tx_state );
+    parlio_transmit_config_t tx_cfg = { .idle_value = 0 };
+    pio_share.sending          = pio_share.staged;
+    pio_share.staged           = 0;
+    pio_share.tx_state.tx_busy = 1;
+    esp_err_t res = parlio_tx_unit_transmit( pio_share.chan, pio_share.buf,
+                                             pio_share.buf_bytes * 8, &tx_cfg );
+    if ( res != ESP_OK ) {
+        log_d( "parlio_strip_flush: shared transmit failed - %s", esp_err_to_name( res ) );
+        pio_share.tx_state.tx_busy = 0;
+        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+            if ( ( pio_share.sending >> n ) & 1 ) {
+                pio_share.cfgs[ n ]->tx_state.tx_busy = 0;
+            }
+        }
+        pio_share.sending = 0;
+    }
+    return res;
+}
+
+// esp_timer callback: the window for the other lanes has closed.
+static void parlio_share_window( void *arg ) {
+    xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+    if ( pio_share.staged && pio_share.chan ) {
+        parlio_share_send();
+    }
+    xSemaphoreGive( pio_share.lock );
+}
+
+// Send anything still staged, then delete the TX unit.  The frame buffer is
+// kept for the next build.
+static esp_err_t parlio_share_stop( void ) {
+    esp_err_t res;
+    if ( pio_share.chan ) {
+        if ( pio_share.staged ) {
+            parlio_share_send();
+        }
+        if ( ( res = parlio_tx_unit_wait_all_done( pio_share.chan, -1 ) ) != ESP_OK ||
+                ( res = parlio_tx_unit_disable( pio_share.chan ) ) != ESP_OK ||
+                ( res = parlio_del_tx_unit( pio_share.chan ) ) != ESP_OK ) {
+            log_d( "parlio_strip_share: TX unit teardown failed - %s", esp_err_to_name( res ) );
+            return res;
+        }
+        pio_share.chan = NULL;
+    }
+    return ESP_OK;
+}
+
+// DMA bytes of the shared frame for the lanes in mask, strips[ n ] being
+// lane n's strip: as wide as the highest lane needs, as long as the longest.
+static size_t parlio_share_frame_bytes( uint32_t lanes, led_strip_t *const *strips ) {
+    uint8_t lead = 0;
+    while ( !( ( lanes >> lead ) & 1 ) ) {
+        lead++;
+    }
+    const size_t block_bytes = parlio_led_byte_bytes( strips[ lead ]->type, parlio_lanes_width( lanes ) );
+    size_t       pixel_bytes = 0;
+    for ( uint8_t n = lead; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( ( ( lanes >> n ) & 1 ) && PIO_PIXEL_SIZE( strips[ n ] ) > pixel_bytes ) {
+            pixel_bytes = PIO_PIXEL_SIZE( strips[ n ] );
+        }
+    }
+    return ( pixel_bytes * block_bytes + 3 ) & ~( size_t )3;
+}
+
+static void parlio_share_free_buf( void ) {
+    heap_caps_free( pio_share.buf );
+    pio_share.buf       = NULL;
+    pio_share.buf_bytes = 0;
+    pio_share.buf_cap   = 0;
+}
+
+// Create the TX unit for the current lanes: wide enough for the highest
+// lane, a frame as long as the longest one, and every lane encoded from its
+// pixel buffer.  pio_share.buf must already hold that frame; only the TX
+// unit can fail here.
+static esp_err_t parlio_share_build( void ) {
+    uint8_t lead = 0;
+    while ( !( ( pio_share.lanes >> lead ) & 1 ) ) {
+        lead++;
+    }
+    const parlio_led_params_t *p           = &parlio_led_params[ pio_share.strips[ lead ]->type ];
+    const uint8_t              width       = parlio_lanes_width( pio_share.lanes );
+    const size_t               total_bytes = parlio_share_frame_bytes( pio_share.lanes, pio_share.strips );
+
+    uint16_t reset_us = 0;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( ( ( pio_share.lanes >> n ) & 1 ) &&
+                parlio_led_params[ pio_share.strips[ n ]->type ].reset_us > reset_us ) {
+            reset_us = parlio_led_params[ pio_share.strips[ n ]->type ].reset_us;
+        }
+    }
+    if ( !pio_share.buf || total_bytes > pio_share.buf_cap ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // Past the longest lane's end, and any bytes a longer layout left, idle LOW.
+    memset( pio_share.buf, 0, total_bytes );
+
+    parlio_tx_unit_config_t chan_cfg = {};
+    chan_cfg.clk_src            = PARLIO_CLK_SRC_DEFAULT;
+    chan_cfg.data_width          = width;
+    chan_cfg.clk_in_gpio_num     = GPIO_NUM_NC;
+    chan_cfg.clk_out_gpio_num    = GPIO_NUM_NC;
+    chan_cfg.valid_gpio_num      = GPIO_NUM_NC;
+    for ( int i = 0; i < PARLIO_TX_UNIT_MAX_DATA_WIDTH; i++ ) {
+        chan_cfg.data_gpio_nums[ i ] = ( ( pio_share.lanes >> i ) & 1 ) ?
+                                       ( gpio_num_t )pio_share.strips[ i ]->gpio : GPIO_NUM_NC;
+    }
+    chan_cfg.output_clk_freq_hz  = p->clk_hz;
+    chan_cfg.trans_queue_depth   = PIO_TRANS_QUEUE_DEPTH;
+    chan_cfg.max_transfer_size   = total_bytes;
+    chan_cfg.bit_pack_order      = PARLIO_BIT_PACK_ORDER_MSB;
+    chan_cfg.flags.clk_gate_en   = false;
+
+    esp_err_t res = parlio_new_tx_unit( &chan_cfg, &pio_share.chan );
+    if ( res == ESP_OK ) {
+        if ( ( res = parlio_tx_attach( pio_share.chan, &pio_share.tx_state, false, reset_us ) ) == ESP_OK ) {
+            pio_share.tx_state.done_cb  = parlio_share_sent;
+            pio_share.tx_state.done_arg = &pio_share;
+            res = parlio_tx_unit_enable( pio_share.chan );
+        }
+        if ( res != ESP_OK ) {
+            parlio_del_tx_unit( pio_share.chan );
+            pio_share.chan = NULL;
+        }
+    }
+    if ( res != ESP_OK ) {
+        log_d( "parlio_strip_share: TX unit create / enable failed - %s", esp_err_to_name( res ) );
+        return res;
     }
+    pio_share.buf_bytes  = total_bytes;
+    pio_share.data_width = width;
+    pio_share.staged     = 0;
+
     for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
-        if ( cfg->lanes[ n ].assigned && cfg->lanes[ n ].strip.buf ) {
-            free( cfg->lanes[ n ].strip.buf );
-            cfg->lanes[ n ].strip.buf = NULL;
+        if ( ( pio_share.lanes >> n ) & 1 ) {
+            led_strip_t *strip = pio_share.strips[ n ];
+            parlio_share_encode( n, 0, PIO_PIXEL_SIZE( strip ) );
+            led_strip_clean( strip );
+            pio_share.cfgs[ n ]->parlio_chan = pio_share.chan;
+            pio_share.cfgs[ n ]->data_width  = width;
         }
     }
+    log_d( "parlio_strip_share: %u lanes on a shared TX unit, data_width %u, %u byte frame",
+           pio_share.lane_count, width, total_bytes );
     return ESP_OK;
 }
 
+static void parlio_share_add( uint8_t n, led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    pio_share.strips[ n ] = strip;
+    pio_share.cfgs[ n ]   = cfg;
+    pio_share.lanes      |= 1UL << n;
+    pio_share.lane_count++;
+    cfg->share_lane       = n;
+    cfg->tx_state.tx_busy = 0;
+}
+
+static void parlio_share_remove( uint8_t n ) {
+    pio_share.cfgs[ n ]->share_lane  = -1;
+    pio_share.cfgs[ n ]->parlio_chan = NULL;
+    pio_share.strips[ n ] = NULL;
+    pio_share.cfgs[ n ]   = NULL;
+    pio_share.lanes      &= ~( 1UL << n );
+    pio_share.lane_count--;
+}
+
+// Rebuild after lanes left, on the frame buffer the larger layout used.  If
+// that fails, the remaining instances are left without a TX unit (isValid()
+// turns false) until they are freed.  The buffer goes with the last lane.
+static esp_err_t parlio_share_rebuild( void ) {
+    if ( !pio_share.lane_count ) {
+        parlio_share_free_buf();
+        return ESP_OK;
+    }
+    esp_err_t res = parlio_share_build();
+    if ( res != ESP_OK ) {
+        for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+            if ( ( pio_share.lanes >> n ) & 1 ) {
+                pio_share.cfgs[ n ]->parlio_chan = NULL;
+            }
+        }
+    }
+    return res;
+}
+
+// Called with the lock held.
+static esp_err_t parlio_share_join( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    led_strip_t *peer = pio_solo_strip;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( ( pio_share.lanes >> n ) & 1 ) {
+            peer = pio_share.strips[ n ];
+            break;
+        }
+    }
+    if ( !peer ) {
+        log_d( "parlio_strip_share: the TX unit is not held by a LiteLEDpio" );
+        return ESP_ERR_NOT_FOUND;
+    }
+    if ( !parlio_led_fits( peer->type, strip->type ) ) {
+        log_d( "parlio_strip_share: LED type %u cannot share a TX unit with type %u (clock or samples per bit differ)",
+               strip->type, peer->type );
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if ( pio_share.lane_count + ( pio_share.lane_count ? 1 : 2 ) > PARLIO_TX_UNIT_MAX_DATA_WIDTH ) {
+        log_d( "parlio_strip_share: all %u data lines are in use", PARLIO_TX_UNIT_MAX_DATA_WIDTH );
+        return ESP_ERR_NOT_FOUND;
+    }
+    if ( parlio_strip_alloc_pixels( strip ) != ESP_OK ) {
+        log_d( "parlio_strip_share: failed to allocate pixel buffer" );
+        return ESP_ERR_NO_MEM;
+    }
+
+    // The lanes after the join: the owner of the unit becomes lane 0 the
+    // first time, and the new strip takes the lowest free lane.
+    led_strip_t        *solo_strip = pio_solo_strip;
+    parlio_strip_cfg_t *solo_cfg   = pio_solo_cfg;
+    led_strip_t        *strips[ PARLIO_TX_UNIT_MAX_DATA_WIDTH ];
+    uint32_t            lanes = pio_share.lanes;
+    memcpy( strips, pio_share.strips, sizeof( strips ) );
+    if ( !lanes ) {
+        strips[ 0 ] = solo_strip;
+        lanes       = 1;
+    }
+    uint8_t lane = 0;
+    while ( ( lanes >> lane ) & 1 ) {
+        lane++;
+    }
+    strips[ lane ] = strip;
+    lanes         |= 1UL << lane;
+
+    // Shared frames are not streamed: get the whole joined frame before the
+    // running unit is touched, so a strip that does not fit leaves the others
+    // as they are.
+    const size_t frame_bytes = parlio_share_frame_bytes( lanes, strips );
+    uint8_t     *frame       = NULL;
+    if ( frame_bytes > pio_share.buf_cap ) {
+        frame = ( uint8_t * )heap_caps_calloc( 1, frame_bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL );
+        if ( !frame ) {
+            log_d( "parlio_strip_share: no DMA RAM for a %u byte shared frame", frame_bytes );
+            free( strip->buf );
+            strip->buf = NULL;
+            return ESP_ERR_NOT_FOUND;
+        }
+    }
+
+    esp_err_t res = pio_share.lane_count ? parlio_share_stop() : parlio_strip_release( solo_cfg );
+    if ( res != ESP_OK ) {
+        heap_caps_free( frame );
+        free( strip->buf );
+        strip->buf = NULL;
+        return res;
+    }
+    if ( frame ) {
+        heap_caps_free( pio_share.buf );
+        pio_share.buf     = frame;
+        pio_share.buf_cap = frame_bytes;
+    }
+    const bool was_solo = ( pio_share.lane_count == 0 );
+    if ( was_solo ) {
+        parlio_share_add( 0, solo_strip, solo_cfg );
+    }
+    parlio_share_add( lane, strip, cfg );
+
+    if ( ( res = parlio_share_build() ) != ESP_OK ) {
+        // Put the others back as they were: the owner on a unit of its own,
+        // or the remaining lanes on the frame buffer, which is big enough.
+        parlio_share_remove( lane );
+        free( strip->buf );
+        strip->buf = NULL;
+        if ( was_solo ) {
+            parlio_share_remove( 0 );
+            parlio_share_free_buf();
+            led_strip_mark_dirty( solo_strip, 0, PIO_PIXEL_SIZE( solo_strip ) );
+            if ( parlio_strip_open( solo_strip, solo_cfg ) != ESP_OK ) {
+                log_d( "parlio_strip_share: the owner of the TX unit could not get it back" );
+            }
+        }
+        else {
+            parlio_share_rebuild();
+        }
+    }
+    return res;
+}
+
+// -------------------------------------------------------------------------
+esp_err_t parlio_strip_share( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    if ( !( strip && cfg && cfg->share_lane < 0 ) ) {
+        log_d( "parlio_strip_share: invalid arguments" );
+        return ESP_ERR_INVALID_ARG;
+    }
+    if ( !pio_share.lock ) {
+        // Created once, on the first share, and kept.
+        esp_timer_create_args_t timer_args = {};
+        timer_args.callback        = parlio_share_window;
+        timer_args.dispatch_method = ESP_TIMER_TASK;
+        timer_args.name            = "LiteLED share";
+        SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+        if ( !lock ) {
+            return ESP_ERR_NO_MEM;
+        }
+        // One give per waiter and frame; excess gives are dropped.
+        pio_share.sent = xSemaphoreCreateCounting( PARLIO_TX_UNIT_MAX_DATA_WIDTH, 0 );
+        if ( !pio_share.sent ) {
+            vSemaphoreDelete( lock );
+            return ESP_ERR_NO_MEM;
+        }
+        esp_err_t res = esp_timer_create( &timer_args, &pio_share.window );
+        if ( res != ESP_OK ) {
+            log_d( "parlio_strip_share: failed to create window timer - %s", esp_err_to_name( res ) );
+            vSemaphoreDelete( pio_share.sent );
+            pio_share.sent = NULL;
+            vSemaphoreDelete( lock );
+            return res;
+        }
+        pio_share.lock = lock;
+    }
+    xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+    esp_err_t res = parlio_share_join( strip, cfg );
+    xSemaphoreGive( pio_share.lock );
+    return res;
+}
+
+// Leave the shared unit.  The pixel buffer is freed by the caller.
+static esp_err_t parlio_share_leave( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+    esp_err_t res = parlio_share_stop();
+    if ( res == ESP_OK ) {
+        parlio_share_remove( cfg->share_lane );
+        if ( parlio_share_rebuild() != ESP_OK ) {
+            log_d( "parlio_strip_free: the other shared lanes lost their TX unit" );
+        }
+    }
+    xSemaphoreGive( pio_share.lock );
+    return res;
+}
+
+// Encode this lane's changes into the shared frame and send the frame if
+// every lane is now staged.  Returns without waiting for the transfer.
+static esp_err_t parlio_share_stage( led_strip_t *strip, parlio_strip_cfg_t *cfg ) {
+    if ( !( strip && strip->buf ) ) {
+        log_d( "parlio_strip_flush: called on uninitialized strip or config" );
+        return ESP_ERR_INVALID_ARG;
+    }
+    const uint32_t bit = 1UL << cfg->share_lane;
+    esp_err_t      res = ESP_OK;
+
+    xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+    if ( pio_share.staged & bit ) {
+        // This lane's previous frame has not gone out yet: send it first.
+        res = parlio_share_send();
+    }
+    if ( res == ESP_OK ) {
+        // The frame is owned by the DMA until the previous transfer is done.
+        res = parlio_share_block( &pio_share.tx_state.tx_busy, portMAX_DELAY );
+    }
+    if ( res == ESP_OK && !pio_share.chan ) {
+        res = ESP_ERR_INVALID_STATE;    // a rebuild failed while we waited
+    }
+    if ( res == ESP_OK ) {
+        size_t hi = strip->dirty_hi;
+        hi = ( hi > PIO_PIXEL_SIZE( strip ) ) ? PIO_PIXEL_SIZE( strip ) : hi;
+        parlio_share_encode( cfg->share_lane, strip->dirty_lo, hi );
+        led_strip_clean( strip );
+        cfg->tx_state.tx_busy = 1;
+        pio_share.staged |= bit;
+        if ( pio_share.staged == pio_share.lanes ) {
+            res = parlio_share_send();
+        }
+        else if ( pio_share.staged == bit ) {
+            esp_timer_start_once( pio_share.window, LL_PARLIO_SHARE_WINDOW_US );
+        }
+    }
+    xSemaphoreGive( pio_share.lock );
+    return res;
+}
+
+// Send the frame now if this lane is still staged, then wait for it.
+static esp_err_t parlio_share_wait( parlio_strip_cfg_t *cfg, int timeout_ms ) {
+    esp_err_t res = ESP_OK;
+    xSemaphoreTake( pio_share.lock, portMAX_DELAY );
+    if ( pio_share.staged & ( 1UL << cfg->share_lane ) ) {
+        res = parlio_share_send();
+    }
+    if ( res == ESP_OK ) {
+        res = parlio_share_block( &cfg->tx_state.tx_busy,
+                                  ( timeout_ms < 0 ) ? portMAX_DELAY : pdMS_TO_TICKS( timeout_ms ) );
+    }
+    xSemaphoreGive( pio_share.lock );
+    if ( res != ESP_OK && res != ESP_ERR_TIMEOUT ) {
+        log_d( "parlio_strip_wait: shared frame failed - %s", esp_err_to_name( res ) );
+    }
+    return res;
+}
+
 #endif /* SOC_PARLIO_SUPPORTED */
 
 //  --- EOF --- //
@@ -9,18 +9,49 @@
 
     Design notes
     ------------
-    * Clock: 2.5 MHz (400 ns per PARLIO sample), 3 samples per LED bit.
-    * Bit encoding:
+    * Clock and samples per LED bit come from parlio_led_params, which
+      ll_led_timings.h synthesizes from each type's nanosecond spec.
+      WS2812: 2.5 MHz (400 ns per PARLIO sample), 3 samples per LED bit:
          LED data 0  →  PARLIO samples [H, L, L]  (pattern 0b100)
          LED data 1  →  PARLIO samples [H, H, L]  (pattern 0b110)
-      Each input byte (8 bits) expands exactly to 3 output bytes; alignment
-      is always on a byte boundary.
-    * Reset: PARLIO_RESET_BYTES zero-bytes appended to every DMA transfer
-      (400 µs LOW), satisfying all currently supported LED types.
-    * Brightness scaling is applied when encoding (at flush time), matching
-      the RMT encoder callback behaviour.
+      APA106 needs 4 samples per bit.  Each input byte (8 bits) expands
+      exactly to samples_per_bit output bytes per data line; alignment is
+      always on a byte boundary.
+    * Single-strip expansion is table driven: a 16-entry nibble table built
+      from parlio_led_params at install gives the 8 x samples_per_bit DMA
+      bytes of an input byte as aligned 32-bit stores.
+    * Reset: not part of the DMA buffer.  Transfers end with idle_value 0,
+      the TX done callback stamps the time, and the next transmit is held
+      off until the LED type's reset_us (50 µs for WS2812) has passed.
+      Encoding the next frame normally covers it, so no time is lost.
+    * Brightness scaling is applied when encoding (at flush time) through the
+      strip's 256-entry brightness lookup table, shared with the RMT encoder.
     * DMA buffer is allocated from internal DMA-capable RAM regardless of
       the PSRAM preference for the pixel colour buffer.
+    * Streaming: when the encoded frame would exceed LL_PARLIO_STREAM_THRESHOLD
+      bytes, the DMA buffer is two chunks of about LL_PARLIO_STREAM_CHUNK_BYTES
+      instead.  flush encodes one chunk while the other is on the wire and
+      queues it; the PARLIO transmit-done callback hands finished chunks back.
+      Chunks end on LED byte boundaries, so the short restart gap between two
+      transfers only stretches the LOW phase of a bit.  The next chunk must be
+      queued before the current one drains (one chunk of wire time, e.g.
+      ~3.3 ms at data_width 8), or the strip sees a reset and latches early.
+    * Double buffering: the first showAsync() adds a second whole-frame DMA
+      buffer (parlio_back).  Each frame is encoded into it while the previous
+      frame is still being sent from parlio_buf, then the two swap.  The TX
+      done callback clears tx_state.tx_busy and runs the user callback.
+    * Whole-frame buffers keep their encoded bytes: only each strip's (or
+      group lane's) dirty pixel range is re-encoded on the next flush.
+    * Shared TX unit: when a LiteLEDpio finds no TX unit free and the one in
+      use belongs to another LiteLEDpio, both become lanes (data lines) of
+      one shared unit (parlio_strip_share).  Lanes may differ in length and
+      in LED type, as long as the types share clock and samples per bit.
+      showAsync() on a lane encodes only that lane into the shared frame and
+      returns; the frame is sent once every lane is staged, or
+      LL_PARLIO_SHARE_WINDOW_US after the first one was.  show() stages its
+      lane, sends the frame at once and waits for it, so blocking show()
+      calls merge nothing: each sends a frame as long as the longest lane.
+      Whole frames only.
 */
 
 #ifndef __LL_PARLIO_CORE_H__
@@ -36,6 +67,25 @@
 
     #if SOC_PARLIO_SUPPORTED
 
+        // Encoded frames larger than this many DMA bytes are streamed through
+        // two chunks instead of one whole-frame buffer.
+        #ifndef LL_PARLIO_STREAM_THRESHOLD
+            #define LL_PARLIO_STREAM_THRESHOLD  32768
+        #endif
+
+        // Target DMA bytes per streaming chunk (rounded to whole LED bytes and
+        // at least one reset period).  Bigger chunks tolerate longer task
+        // preemption; two of them are allocated.
+        #ifndef LL_PARLIO_STREAM_CHUNK_BYTES
+            #define LL_PARLIO_STREAM_CHUNK_BYTES  8192
+        #endif
+
+        // Shared TX unit: how long the first lane staged by showAsync() waits for the
+        // other lanes before the frame is sent without them.
+        #ifndef LL_PARLIO_SHARE_WINDOW_US
+            #define LL_PARLIO_SHARE_WINDOW_US  2000
+        #endif
+
         // -------------------------------------------------------------------------
         // Function declarations
         // -------------------------------------------------------------------------
@@ -47,20 +97,38 @@
         // buffer, create and enable the PARLIO TX channel.
         esp_err_t parlio_strip_install( led_strip_t *strip, parlio_strip_cfg_t *cfg );
 
+        // Join the shared TX unit after parlio_strip_install() found no unit
+        // free (ESP_ERR_NOT_FOUND).  Allocates the pixel buffer; the strip that
+        // owned the unit moves onto it as well.  Returns ESP_ERR_NOT_FOUND if
+        // the unit is not held by a LiteLEDpio or all data lines are taken,
+        // ESP_ERR_NOT_SUPPORTED if the LED timing cannot share the clock.
+        esp_err_t parlio_strip_share( led_strip_t *strip, parlio_strip_cfg_t *cfg );
+
         // Wait for any in-progress transfer to finish, disable and delete the
-        // PARLIO TX channel, and free both buffers.
+        // PARLIO TX channel (or leave the shared one), and free both buffers.
         esp_err_t parlio_strip_free( led_strip_t *strip, parlio_strip_cfg_t *cfg );
 
         // Encode pixel colour buffer → DMA bitstream (applying brightness), then
-        // send via PARLIO DMA and block until the transfer (including reset) is done.
+        // send via PARLIO DMA and block until the transfer is done.  A shared
+        // lane is staged and the frame sent with every lane staged so far.
         esp_err_t parlio_strip_flush( led_strip_t *strip, parlio_strip_cfg_t *cfg );
 
+        // As parlio_strip_flush(), but return once the frame is queued.  The
+        // first call allocates a second frame buffer so the next frame can be
+        // encoded while this one is sent.  Streamed frames still block.  A
+        // shared lane returns once it is staged (see the design notes).
+        esp_err_t parlio_strip_flush_async( led_strip_t *strip, parlio_strip_cfg_t *cfg );
+
+        // Wait up to timeout_ms (-1 = forever) for the frame on the wire to finish.
+        // Returns ESP_ERR_TIMEOUT if it is still being sent.
+        esp_err_t parlio_strip_wait( parlio_strip_cfg_t *cfg, int timeout_ms );
+
         // Dump PARLIO strip configuration to the debug log.
         void parlio_strip_debug_dump( led_strip_t *strip, parlio_strip_cfg_t *cfg );
 
         // ---- Multi-strip group functions (used by LiteLEDpioGroup) ----------
 
-        // Allocate per-lane pixel buffers and the shared DMA bitstream buffer,
+        // Allocate one pixel arena for all lanes and the shared DMA bitstream buffer,
         // then create and enable the PARLIO TX unit with all assigned lane GPIOs.
         // cfg->lanes[n].assigned and cfg->lanes[n].strip must be pre-populated
         // by LiteLEDpioGroup before calling this.
@@ -70,8 +138,21 @@
         // (applying per-lane brightness), then transmit and block until done.
         esp_err_t parlio_group_flush( parlio_group_cfg_t *cfg );
 
+        // Group counterparts of parlio_strip_flush_async() / parlio_strip_wait().
+        esp_err_t parlio_group_flush_async( parlio_group_cfg_t *cfg );
+        esp_err_t parlio_group_wait( parlio_group_cfg_t *cfg, int timeout_ms );
+
+        #if LL_PARLIO_TX_UNITS > 1
+        // Send count groups (at most LL_PARLIO_TX_UNITS) as one frame: encode
+        // them all, then queue their transfers back to back.  flush blocks until
+        // every group is done, flush_async returns once all are queued.
+        // Streamed groups are refused with ESP_ERR_NOT_SUPPORTED.
+        esp_err_t parlio_groups_flush( parlio_group_cfg_t *const cfgs[], uint8_t count );
+        esp_err_t parlio_groups_flush_async( parlio_group_cfg_t *const cfgs[], uint8_t count );
+        #endif
+
         // Wait for any in-progress transfer, disable and delete the PARLIO TX
-        // unit, and free all per-lane pixel buffers and the DMA buffer.
+        // unit, and free the lanes' pixel arena and the DMA buffer.
         esp_err_t parlio_group_free( parlio_group_cfg_t *cfg );
 
     #endif /* SOC_PARLIO_SUPPORTED */
@@ -175,6 +175,19 @@ uint8_t ll_registry_get_active_count( void ) {
     return count;
 }
 
+// Get count of RMT TX channels in use by anyone (queries periman)
+uint8_t ll_registry_get_rmt_tx_count( void ) {
+    uint8_t count = 0;
+
+    for ( int gpio = 0; gpio < SOC_GPIO_PIN_COUNT; gpio++ ) {
+        if ( perimanGetPinBusType( gpio ) == ESP32_BUS_TYPE_RMT_TX ) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
 // Peripheral Manager deinit callback - called when GPIO is being reassigned
 bool ll_periman_deinit_callback( void *bus_handle ) {
     if ( !bus_handle ) {
@@ -36,6 +36,9 @@ LiteLED* ll_get_instance_by_gpio( uint8_t gpio );
 // Get active instance count (queries periman)
 uint8_t ll_registry_get_active_count( void );
 
+// Get count of GPIOs driven by any RMT TX channel, LiteLED or not (queries periman)
+uint8_t ll_registry_get_rmt_tx_count( void );
+
 // Peripheral Manager deinit callback - called when GPIO is reassigned
 bool ll_periman_deinit_callback( void *bus_handle );
 
@@ -4,6 +4,75 @@
 */
 
 #include "ll_strip_core.h"
+#include "ll_strip_pixels.h"
+#include "ll_registry.h"
+#include "esp_memory_utils.h"
+
+// String names for the led encoder modes, indexed by ll_encoder_t (for debugging)
+const char *const ll_encoder_name[] = {
+    "byte",
+    "batch",
+    "staged",
+    "frame"
+};
+
+static IRAM_ATTR bool led_strip_tx_done( rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_ctx ) {
+    /* RMT TX done ISR: ends a show() frame and runs the user callback. hold() repeats are ignored */
+    led_strip_t *strip = ( led_strip_t* )user_ctx;
+    if ( strip->stripCfg.tx_busy ) {
+        strip->stripCfg.tx_busy = 0;
+        if ( strip->stripCfg.done_cb ) {
+            strip->stripCfg.done_cb( strip->stripCfg.done_arg );
+        }
+    }
+    return false;   // no task woken
+}
+
+static void led_strip_size_mem( led_strip_t *strip ) {
+    /* Chooses the RMT memory block and encoder chunk sizes from strip length, DMA use and live channels */
+    const size_t block = LL_MEM_BLOCK_SIZE_DEFAULT;
+    size_t frame_symbols = PIXEL_SIZE( strip ) * 8 + 1;
+    size_t blocks_needed = ( frame_symbols + block - 1 ) / block;
+    size_t mem_symbols;
+
+    if ( strip->stripCfg.led_chan_config.flags.with_dma ) {
+        // DMA buffer only as large as the frame needs, in whole blocks, up to LL_MEM_BLOCK_SIZE_DMA
+        mem_symbols = blocks_needed * block;
+        if ( mem_symbols > LL_MEM_BLOCK_SIZE_DMA ) {
+            mem_symbols = LL_MEM_BLOCK_SIZE_DMA;
+        }
+    }
+    else {
+        // Borrow memory blocks from unused channels: no more than the frame needs and
+        // at most half of the free channels, so later strips can still get a channel
+        uint8_t live = ll_registry_get_rmt_tx_count();
+        size_t blocks = ( LL_RMT_TX_CHANNELS > live ) ? ( LL_RMT_TX_CHANNELS - live ) / 2 : 1;
+        if ( blocks > blocks_needed ) {
+            blocks = blocks_needed;
+        }
+        if ( blocks > LL_MEM_BLOCKS_MAX ) {
+            blocks = LL_MEM_BLOCKS_MAX;
+        }
+        if ( blocks < 1 ) {
+            blocks = 1;
+        }
+        mem_symbols = blocks * block;
+    }
+    strip->stripCfg.led_chan_config.mem_block_symbols = mem_symbols;
+
+    // Each refill has half of the memory free; the encoder chunk must fit in it (and be whole bytes)
+    size_t chunk = ( mem_symbols / 2 ) & ~( size_t )7;
+    if ( chunk > LL_ENCODER_MIN_CHUNK_SIZE ) {
+        chunk = LL_ENCODER_MIN_CHUNK_SIZE;
+    }
+    if ( chunk < 8 ) {
+        chunk = 8;
+    }
+    strip->stripCfg.led_encoder_cfg.min_chunk_size = chunk;
+
+    log_d( "RMT memory set to %d symbols (%d block(s)), encoder chunk %d symbols.",
+           mem_symbols, mem_symbols / block, chunk );
+}
 
 esp_err_t led_strip_init( led_strip_t *strip ) {
     /* Initializes all structures and variables required for the library */
@@ -33,8 +102,21 @@ esp_err_t led_strip_init( led_strip_t *strip ) {
     };
 
     log_d( "Defining the led encoder configuration." );
+    strip->stripCfg.enc_pos = 0;
+    strip->stripCfg.enc_mode = ENCODER_DEFAULT;
+    strip->stripCfg.sym_lut = NULL;
+    strip->stripCfg.enc_buf = NULL;
+    strip->stripCfg.frame_buf = NULL;
+    strip->stripCfg.frame_symbols = 0;
+    strip->stripCfg.hold_encoder = NULL;
+    strip->stripCfg.hold_timer = NULL;
+    strip->stripCfg.hold_mode = LL_HOLD_NONE;
+    strip->stripCfg.hold_refreshing = 0;
+    strip->stripCfg.reset_sym = led_params[ strip->type ].led_reset;
+    strip->stripCfg.tx_busy = 0;
+    // done_cb / done_arg belong to the owner (LiteLED clears them once, in its constructor)
     strip->stripCfg.led_encoder_cfg = {
-        led_encoder_cb,                         /* The led encoder function */
+        led_encoder_batch_cb,                   /* The led encoder function */
         strip,                                  /* Args for the led encoder function */
         ( size_t )LL_ENCODER_MIN_CHUNK_SIZE,    /* Explicitly set - default is 64 */
     };
@@ -48,6 +130,8 @@ esp_err_t led_strip_init( led_strip_t *strip ) {
         }
     };
 
+    led_strip_size_mem( strip );
+
     log_d( "RMT driver configuration successful." );
     return ESP_OK;
 }
@@ -68,27 +152,90 @@ esp_err_t led_strip_init_modify( led_strip_t *strip, ll_dma_t use_dma, ll_priori
 #if LL_DMA_SUPPORT
     strip->stripCfg.led_chan_config.flags.with_dma = use_dma;
     log_d( "Setting the RMT DMA usage to %s.", use_dma ? "ON" : "OFF" );
-    if ( use_dma ) {
-        strip->stripCfg.led_chan_config.mem_block_symbols = ( size_t )LL_MEM_BLOCK_SIZE_DMA;
-        log_d( "RMT DMA enabled. Setting the memory block size to %d.", strip->stripCfg.led_chan_config.mem_block_symbols );
-    }
-    else {
-        strip->stripCfg.led_chan_config.mem_block_symbols = ( size_t )LL_MEM_BLOCK_SIZE_DEFAULT;
-        log_d( "RMT DMA disabled. Setting the memory block size to %d.", strip->stripCfg.led_chan_config.mem_block_symbols );
-    }
 #else
     strip->stripCfg.led_chan_config.flags.with_dma = DMA_OFF;
-    strip->stripCfg.led_chan_config.mem_block_symbols = LL_MEM_BLOCK_SIZE_DEFAULT;
     log_d( "RMT DMA not supported on this ESP32 model. Disabling DMA." );
 #endif
+    led_strip_size_mem( strip );
 
     return res;
 }
 
+esp_err_t led_strip_init_encoder( led_strip_t *strip, ll_encoder_t enc_mode ) {
+    /* Selects the RMT led encoder used to convert the LED buffer to RMT symbols */
+    switch ( enc_mode ) {
+        case ENCODER_BYTE:
+            strip->stripCfg.led_encoder_cfg.callback = led_encoder_cb;
+            log_d( "Setting the RMT led encoder to per-byte mode." );
+            break;
+        case ENCODER_BATCH:
+            strip->stripCfg.led_encoder_cfg.callback = led_encoder_batch_cb;
+            log_d( "Setting the RMT led encoder to batch mode." );
+            break;
+        case ENCODER_STAGED:
+            log_d( "Setting the RMT led encoder to staged bytes encoder mode." );
+            break;
+        case ENCODER_FRAME:
+#if LL_DMA_SUPPORT
+            log_d( "Setting the RMT led encoder to pre-encoded frame mode." );
+            if ( !strip->stripCfg.led_chan_config.flags.with_dma ) {
+                log_d( "Note: Pre-encoded frame mode works best with RMT DMA enabled." );
+            }
+#else
+            log_d( "Pre-encoded frame mode requires RMT DMA, not supported on this ESP32 model. Using batch mode." );
+            strip->stripCfg.led_encoder_cfg.callback = led_encoder_batch_cb;
+            enc_mode = ENCODER_BATCH;
+#endif
+            break;
+        default:
+            log_d( "Error: Invalid led encoder specifier." );
+            return ESP_ERR_INVALID_ARG;
+    }
+    strip->stripCfg.enc_mode = enc_mode;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_alloc_frame( led_strip_t *strip ) {
+    /* Allocates the frame symbol buffer: 8 symbols per LED data byte plus the reset symbol */
+    size_t frame_symbols = PIXEL_SIZE( strip ) * 8 + 1;
+    size_t frame_bytes = frame_symbols * sizeof( rmt_symbol_word_t );
+#if CONFIG_SPIRAM
+    if ( strip->use_psram && psramFound() ) {
+        strip->stripCfg.frame_buf = ( rmt_symbol_word_t* )heap_caps_malloc( frame_bytes, MALLOC_CAP_SPIRAM );
+        if ( strip->stripCfg.frame_buf ) {
+            log_d( "Frame symbol buffer allocated in PSRAM (%d bytes)", frame_bytes );
+        }
+    }
+#endif
+    if ( !strip->stripCfg.frame_buf ) {
+        strip->stripCfg.frame_buf = ( rmt_symbol_word_t* )heap_caps_malloc( frame_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+        if ( strip->stripCfg.frame_buf ) {
+            log_d( "Frame symbol buffer allocated in internal RAM (%d bytes)", frame_bytes );
+        }
+    }
+    if ( !strip->stripCfg.frame_buf ) {
+        log_d( "Error: Failed to allocate frame symbol buffer (%d bytes) - ESP_ERR_NO_MEM.", frame_bytes );
+        return ESP_ERR_NO_MEM;
+    }
+    strip->stripCfg.frame_symbols = frame_symbols;
+    return ESP_OK;
+}
+
 esp_err_t led_strip_install( led_strip_t *strip ) {
     /* Installs the LED strip and allocates the necessary resources */
     size_t buffer_size = strip->length * COLOR_SIZE( strip );
 
+#if LL_ISR_IRAM_SAFE
+    // The RMT ISR reads the pixel and frame buffers and runs while the flash cache (and so PSRAM) is off
+    if ( strip->use_psram ) {
+        log_d( "CONFIG_RMT_ISR_IRAM_SAFE is set, ignoring PSRAM request so the ISR only reads internal RAM" );
+        strip->use_psram = false;
+    }
+    if ( !esp_ptr_internal( strip ) ) {
+        log_d( "Warning: strip object is not in internal RAM; output may glitch during flash writes." );
+    }
+#endif
+
     // Allocate buffer based on PSRAM preference
     if ( strip->use_psram ) {
 #if CONFIG_SPIRAM
@@ -138,7 +285,10 @@ esp_err_t led_strip_install( led_strip_t *strip ) {
         return ESP_ERR_NO_MEM;
     }
 
+    led_strip_build_bright_lut( strip );
+
     esp_err_t res = ESP_OK;
+    rmt_tx_event_callbacks_t tx_callbacks = {};
 
 #if LL_INT_PRIORITY_SUPPORT
     int original_priority = strip->stripCfg.led_chan_config.intr_priority;
@@ -151,7 +301,8 @@ esp_err_t led_strip_install( led_strip_t *strip ) {
     if ( best_priority < 0 ) {
         log_d( "Error: No interrupt priorities available! Maximum number of RMT channels may be exceeded" );
         log_d( "       Active channels: %d. May need to reduce the number of concurrent displays or reduce RMT DMA usage", ll_active_channels );
-        return ESP_ERR_NO_MEM;
+        res = ESP_ERR_NO_MEM;
+        goto err;
     }
 
     if ( best_priority != original_priority ) {
@@ -195,6 +346,15 @@ esp_err_t led_strip_install( led_strip_t *strip ) {
 #endif
     }
 
+    // Extra memory blocks may have been claimed by another channel in the meantime: retry with one block
+    if ( res == ESP_ERR_NOT_FOUND && !strip->stripCfg.led_chan_config.flags.with_dma &&
+            strip->stripCfg.led_chan_config.mem_block_symbols > LL_MEM_BLOCK_SIZE_DEFAULT ) {
+        log_d( "No room for %d RMT symbols, retrying with a single memory block.", strip->stripCfg.led_chan_config.mem_block_symbols );
+        strip->stripCfg.led_chan_config.mem_block_symbols = LL_MEM_BLOCK_SIZE_DEFAULT;
+        strip->stripCfg.led_encoder_cfg.min_chunk_size = ( LL_MEM_BLOCK_SIZE_DEFAULT / 2 ) & ~( size_t )7;
+        res = rmt_new_tx_channel( &strip->stripCfg.led_chan_config, &strip->stripCfg.led_chan );
+    }
+
     // Mark the priority as used if successful
     if ( res == ESP_OK ) {
 #if LL_INT_PRIORITY_SUPPORT
@@ -213,18 +373,61 @@ esp_err_t led_strip_install( led_strip_t *strip ) {
         else {
             log_d( "Error: Failed to create RMT TX channel - %s.", esp_err_to_name( res ) );
         }
-        return res;
+        strip->stripCfg.led_chan = NULL;
+        goto err;
     }
 
-    if ( ( res = rmt_new_simple_encoder( &strip->stripCfg.led_encoder_cfg, &strip->stripCfg.led_encoder ) ) != ESP_OK ) {
-        log_d( "Error: Failed to create LED encoder - %s.", esp_err_to_name( res ) );
-        return res;
+    if ( strip->stripCfg.enc_mode == ENCODER_STAGED ) {
+        // The staging buffer is read by the bytes encoder in the RMT ISR, so keep it in internal RAM
+        strip->stripCfg.enc_buf = ( uint8_t* )heap_caps_calloc( strip->length, COLOR_SIZE( strip ), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT );
+        if ( !strip->stripCfg.enc_buf ) {
+            log_d( "Error: Failed to allocate encoder staging buffer - ESP_ERR_NO_MEM." );
+            res = ESP_ERR_NO_MEM;
+            goto err;
+        }
+        log_d( "Encoder staging buffer allocated in internal RAM (%d bytes)", buffer_size );
+
+        if ( ( res = ll_staged_encoder_new( strip->type, &strip->stripCfg.led_encoder ) ) != ESP_OK ) {
+            log_d( "Error: Failed to create LED encoder - %s.", esp_err_to_name( res ) );
+            goto err;
+        }
+    }
+    else {
+        strip->stripCfg.sym_lut = ll_symbol_lut_acquire( strip->type );
+        if ( !strip->stripCfg.sym_lut ) {
+            log_d( "Error: Failed to get the symbol lookup table - ESP_ERR_NO_MEM." );
+            res = ESP_ERR_NO_MEM;
+            goto err;
+        }
+
+        if ( strip->stripCfg.enc_mode == ENCODER_FRAME ) {
+            if ( ( res = led_strip_alloc_frame( strip ) ) != ESP_OK ) {
+                goto err;
+            }
+
+            rmt_copy_encoder_config_t copy_encoder_config = {};
+            if ( ( res = rmt_new_copy_encoder( &copy_encoder_config, &strip->stripCfg.led_encoder ) ) != ESP_OK ) {
+                log_d( "Error: Failed to create LED encoder - %s.", esp_err_to_name( res ) );
+                goto err;
+            }
+        }
+        else if ( ( res = rmt_new_simple_encoder( &strip->stripCfg.led_encoder_cfg, &strip->stripCfg.led_encoder ) ) != ESP_OK ) {
+            log_d( "Error: Failed to create LED encoder - %s.", esp_err_to_name( res ) );
+            goto err;
+        }
+    }
+
+    // Event callbacks must be registered while the channel is still disabled
+    tx_callbacks.on_trans_done = led_strip_tx_done;
+    if ( ( res = rmt_tx_register_event_callbacks( strip->stripCfg.led_chan, &tx_callbacks, strip ) ) != ESP_OK ) {
+        log_d( "Error: Failed to register RMT TX callbacks - %s.", esp_err_to_name( res ) );
+        goto err;
     }
 
     log_d( "Enabling the RMT TX channel." );
     if ( ( res = rmt_enable( strip->stripCfg.led_chan ) ) != ESP_OK ) {
         log_d( "Error: Failed to enable RMT TX channel - %s.", esp_err_to_name( res ) );
-        return res;
+        goto err;
     }
 
     log_d( "LED strip sucessfully configured and installed." );
@@ -234,6 +437,36 @@ esp_err_t led_strip_install( led_strip_t *strip ) {
 #endif
 
     return res;
+
+err:
+    // Release everything acquired so far, in reverse order, leaving the strip as led_strip_init() did
+    if ( strip->stripCfg.led_encoder ) {
+        rmt_del_encoder( strip->stripCfg.led_encoder );
+        strip->stripCfg.led_encoder = NULL;
+    }
+    if ( strip->stripCfg.frame_buf ) {
+        heap_caps_free( strip->stripCfg.frame_buf );
+        strip->stripCfg.frame_buf = NULL;
+        strip->stripCfg.frame_symbols = 0;
+    }
+    if ( strip->stripCfg.sym_lut ) {
+        ll_symbol_lut_release( strip->type );
+        strip->stripCfg.sym_lut = NULL;
+    }
+    if ( strip->stripCfg.enc_buf ) {
+        heap_caps_free( strip->stripCfg.enc_buf );
+        strip->stripCfg.enc_buf = NULL;
+    }
+    if ( strip->stripCfg.led_chan ) {
+#if LL_INT_PRIORITY_SUPPORT
+        ll_mark_priority_free( strip->stripCfg.led_chan_config.intr_priority );
+#endif
+        rmt_del_channel( strip->stripCfg.led_chan );
+        strip->stripCfg.led_chan = NULL;
+    }
+    free( strip->buf );
+    strip->buf = NULL;
+    return res;
 }
 
 esp_err_t led_strip_free( led_strip_t *strip ) {
@@ -250,6 +483,10 @@ esp_err_t led_strip_free( led_strip_t *strip ) {
 #endif
 
     esp_err_t res = ESP_OK;
+    // An infinite hold loop would never finish, so stop it before waiting
+    if ( ( res = led_strip_hold_stop( strip ) ) != ESP_OK ) {
+        return res;
+    }
     if ( ( res = rmt_tx_wait_all_done( strip->stripCfg.led_chan, portMAX_DELAY ) ) != ESP_OK ) {
         log_d( "Error: Fail on wait for RMT TX to finish - %s.", esp_err_to_name( res ) );
         return res;
@@ -267,6 +504,24 @@ esp_err_t led_strip_free( led_strip_t *strip ) {
         return res;
     }
 
+    if ( strip->stripCfg.hold_encoder ) {
+        rmt_del_encoder( strip->stripCfg.hold_encoder );
+        strip->stripCfg.hold_encoder = NULL;
+    }
+    if ( strip->stripCfg.sym_lut ) {
+        ll_symbol_lut_release( strip->type );
+        strip->stripCfg.sym_lut = NULL;
+    }
+    if ( strip->stripCfg.enc_buf ) {
+        heap_caps_free( strip->stripCfg.enc_buf );
+        strip->stripCfg.enc_buf = NULL;
+    }
+    if ( strip->stripCfg.frame_buf ) {
+        heap_caps_free( strip->stripCfg.frame_buf );
+        strip->stripCfg.frame_buf = NULL;
+        strip->stripCfg.frame_symbols = 0;
+    }
+
     free( strip->buf );
     strip->buf = NULL;
     return res;
@@ -274,15 +529,216 @@ esp_err_t led_strip_free( led_strip_t *strip ) {
 
 esp_err_t led_strip_flush( led_strip_t *strip ) {
     /* Pushes all data from the LED buffer to the LED strip */
+    esp_err_t res = led_strip_flush_async( strip );
+    if ( res != ESP_OK ) {
+        return res;
+    }
+    return led_strip_wait( strip, -1 );
+}
+
+esp_err_t led_strip_wait( led_strip_t *strip, int timeout_ms ) {
+    /* Waits for all queued transmissions on the channel to finish */
+    esp_err_t res = rmt_tx_wait_all_done( strip->stripCfg.led_chan, timeout_ms );
+    if ( res != ESP_OK && res != ESP_ERR_TIMEOUT ) {
+        log_d( "Error: Fail on 'rmt_tx_wait_all_done()'. Result = %s", esp_err_to_name( res ) );
+    }
+    return res;
+}
+
+esp_err_t led_strip_flush_async( led_strip_t *strip ) {
+    /* Encodes (if needed) and queues the LED buffer, returning while the frame is still on the wire */
     esp_err_t res = ESP_OK;
-    if ( ( res = rmt_transmit( strip->stripCfg.led_chan, strip->stripCfg.led_encoder, strip->buf, PIXEL_SIZE( strip ), &strip->stripCfg.led_tx_config ) ) != ESP_OK ) {
+    const void *payload = strip->buf;
+    size_t payload_bytes = PIXEL_SIZE( strip );
+
+    // A new frame replaces any held one
+    if ( ( res = led_strip_hold_stop( strip ) ) != ESP_OK ) {
+        return res;
+    }
+    // The staging and frame buffers, and enc_pos, belong to the frame in flight until it is done
+    if ( ( res = led_strip_wait( strip, -1 ) ) != ESP_OK ) {
+        return res;
+    }
+
+    if ( strip->stripCfg.enc_mode == ENCODER_STAGED ) {
+        // Apply brightness here so the bytes encoder only has to expand bits in the ISR
+        for ( size_t i = 0; i < payload_bytes; i++ ) {
+            strip->stripCfg.enc_buf[ i ] = strip->bright_lut[ strip->buf[ i ] ];
+        }
+        payload = strip->stripCfg.enc_buf;
+    }
+    else if ( strip->stripCfg.enc_mode == ENCODER_FRAME ) {
+        // Encode the whole frame now so the ISR only has to copy symbols out
+        size_t symbols = ll_frame_encode( strip, strip->buf, payload_bytes );
+        payload = strip->stripCfg.frame_buf;
+        payload_bytes = symbols * sizeof( rmt_symbol_word_t );
+    }
+
+    strip->stripCfg.tx_busy = 1;
+    if ( ( res = rmt_transmit( strip->stripCfg.led_chan, strip->stripCfg.led_encoder, payload, payload_bytes, &strip->stripCfg.led_tx_config ) ) != ESP_OK ) {
+        strip->stripCfg.tx_busy = 0;
         log_d( "Error: Fail on 'rmt_transmit()'. Result = %s", esp_err_to_name( res ) );
         return res;
     }
+    return res;
+}
+
+size_t led_strip_refill_irqs( led_strip_t *strip ) {
+    /* The first fill loads the whole memory block; after that each threshold (or DMA half-buffer)
+       interrupt refills half of it, and one more interrupt signals the end of the transmission */
+    if ( !strip || strip->stripCfg.hold_mode == LL_HOLD_LOOP ) {
+        return 0;   // a hardware loop needs no refills
+    }
+    size_t frame_symbols = PIXEL_SIZE( strip ) * 8 + 1;
+    size_t mem_symbols = strip->stripCfg.led_chan_config.mem_block_symbols;
+    size_t refill = mem_symbols / 2;
+    size_t irqs = 1;
+    if ( frame_symbols > mem_symbols && refill > 0 ) {
+        irqs += ( frame_symbols - mem_symbols + refill - 1 ) / refill;
+    }
+    return irqs;
+}
+
+// Orders the hold timer callback against led_strip_hold_stop()
+static portMUX_TYPE ll_hold_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static void led_strip_hold_refresh( void *arg ) {
+    /* esp_timer callback: queue the held frame again. Skips this refresh if the queue is full */
+    led_strip_t *strip = ( led_strip_t* )arg;
+    // led_strip_hold_stop() clears hold_mode first and then waits for hold_refreshing to clear,
+    // so a repeat is either queued before its final rmt_tx_wait_all_done() or not at all
+    portENTER_CRITICAL( &ll_hold_mux );
+    bool held = ( strip->stripCfg.hold_mode == LL_HOLD_TIMER );
+    strip->stripCfg.hold_refreshing = held;
+    portEXIT_CRITICAL( &ll_hold_mux );
+    if ( !held ) {
+        return;
+    }
+    rmt_encoder_handle_t encoder = strip->stripCfg.hold_encoder ? strip->stripCfg.hold_encoder : strip->stripCfg.led_encoder;
+    rmt_transmit_config_t tx_config = {};
+    tx_config.loop_count = 0;
+    tx_config.flags.queue_nonblocking = 1;
+    rmt_transmit( strip->stripCfg.led_chan, encoder, strip->stripCfg.frame_buf,
+                  strip->stripCfg.frame_symbols * sizeof( rmt_symbol_word_t ), &tx_config );
+    strip->stripCfg.hold_refreshing = 0;
+}
+
+esp_err_t led_strip_hold( led_strip_t *strip, uint32_t refresh_ms ) {
+    /* Encodes the LED buffer into the frame symbol buffer once and keeps replaying it */
+    if ( !( strip && strip->buf && refresh_ms > 0 ) ) {
+        log_d( "Error: Strip not initialized or invalid refresh period." );
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t res = ESP_OK;
+    if ( ( res = led_strip_hold_stop( strip ) ) != ESP_OK ) {
+        return res;
+    }
     if ( ( res = rmt_tx_wait_all_done( strip->stripCfg.led_chan, portMAX_DELAY ) ) != ESP_OK ) {
         log_d( "Error: Fail on 'rmt_tx_wait_all_done()'. Result = %s", esp_err_to_name( res ) );
         return res;
     }
+
+    // Everything below is allocated once, on the first hold(), and kept until led_strip_free()
+    if ( !strip->stripCfg.sym_lut ) {
+        strip->stripCfg.sym_lut = ll_symbol_lut_acquire( strip->type );
+        if ( !strip->stripCfg.sym_lut ) {
+            log_d( "Error: Failed to get the symbol lookup table - ESP_ERR_NO_MEM." );
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    if ( !strip->stripCfg.frame_buf ) {
+        if ( ( res = led_strip_alloc_frame( strip ) ) != ESP_OK ) {
+            return res;
+        }
+    }
+    rmt_encoder_handle_t encoder = strip->stripCfg.led_encoder;
+    if ( strip->stripCfg.enc_mode != ENCODER_FRAME ) {
+        if ( !strip->stripCfg.hold_encoder ) {
+            rmt_copy_encoder_config_t copy_encoder_config = {};
+            if ( ( res = rmt_new_copy_encoder( &copy_encoder_config, &strip->stripCfg.hold_encoder ) ) != ESP_OK ) {
+                log_d( "Error: Failed to create hold encoder - %s.", esp_err_to_name( res ) );
+                return res;
+            }
+        }
+        encoder = strip->stripCfg.hold_encoder;
+    }
+
+    strip->stripCfg.frame_symbols = ll_frame_encode( strip, strip->buf, PIXEL_SIZE( strip ) );
+
+    if ( !strip->stripCfg.led_chan_config.flags.with_dma &&
+            strip->stripCfg.frame_symbols <= strip->stripCfg.led_chan_config.mem_block_symbols ) {
+        // The whole frame fits in RMT memory: let the hardware loop it forever, no CPU involved
+        rmt_transmit_config_t tx_config = strip->stripCfg.led_tx_config;
+        tx_config.loop_count = -1;
+        if ( ( res = rmt_transmit( strip->stripCfg.led_chan, encoder, strip->stripCfg.frame_buf,
+                                   strip->stripCfg.frame_symbols * sizeof( rmt_symbol_word_t ), &tx_config ) ) != ESP_OK ) {
+            log_d( "Error: Fail on 'rmt_transmit()' for hold loop. Result = %s", esp_err_to_name( res ) );
+            return res;
+        }
+        strip->stripCfg.hold_mode = LL_HOLD_LOOP;
+        log_d( "Holding frame with an RMT hardware loop (%d symbols).", strip->stripCfg.frame_symbols );
+        return ESP_OK;
+    }
+
+    // Too long for a hardware loop: re-queue the cached symbols from a timer, no re-encoding
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = led_strip_hold_refresh;
+    timer_args.arg = strip;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "LiteLED hold";
+    if ( ( res = esp_timer_create( &timer_args, &strip->stripCfg.hold_timer ) ) != ESP_OK ) {
+        log_d( "Error: Failed to create hold timer - %s.", esp_err_to_name( res ) );
+        return res;
+    }
+    strip->stripCfg.hold_mode = LL_HOLD_TIMER;
+    led_strip_hold_refresh( strip );
+    if ( ( res = esp_timer_start_periodic( strip->stripCfg.hold_timer, ( uint64_t )refresh_ms * 1000 ) ) != ESP_OK ) {
+        log_d( "Error: Failed to start hold timer - %s.", esp_err_to_name( res ) );
+        led_strip_hold_stop( strip );
+        return res;
+    }
+    log_d( "Holding frame with a %u ms refresh timer (%d symbols).", refresh_ms, strip->stripCfg.frame_symbols );
+    return ESP_OK;
+}
+
+esp_err_t led_strip_hold_stop( led_strip_t *strip ) {
+    /* Stops the hardware loop or refresh timer started by led_strip_hold() */
+    esp_err_t res = ESP_OK;
+    switch ( strip->stripCfg.hold_mode ) {
+        case LL_HOLD_LOOP:
+            // An infinite loop transaction can only be ended by disabling the channel
+            if ( ( res = rmt_disable( strip->stripCfg.led_chan ) ) != ESP_OK ) {
+                log_d( "Error: Fail on disable RMT TX channel - %s.", esp_err_to_name( res ) );
+                return res;
+            }
+            rmt_encoder_reset( strip->stripCfg.hold_encoder ? strip->stripCfg.hold_encoder : strip->stripCfg.led_encoder );
+            if ( ( res = rmt_enable( strip->stripCfg.led_chan ) ) != ESP_OK ) {
+                log_d( "Error: Failed to enable RMT TX channel - %s.", esp_err_to_name( res ) );
+                return res;
+            }
+            break;
+        case LL_HOLD_TIMER:
+            // No repeat starts after this; one already running in the esp_timer task is let finish
+            portENTER_CRITICAL( &ll_hold_mux );
+            strip->stripCfg.hold_mode = LL_HOLD_NONE;
+            portEXIT_CRITICAL( &ll_hold_mux );
+            esp_timer_stop( strip->stripCfg.hold_timer );
+            esp_timer_delete( strip->stripCfg.hold_timer );
+            strip->stripCfg.hold_timer = NULL;
+            while ( strip->stripCfg.hold_refreshing ) {
+                delay( 1 );
+            }
+            // Let the last queued repeat finish before the frame buffer can be reused
+            if ( ( res = rmt_tx_wait_all_done( strip->stripCfg.led_chan, portMAX_DELAY ) ) != ESP_OK ) {
+                log_d( "Error: Fail on 'rmt_tx_wait_all_done()'. Result = %s", esp_err_to_name( res ) );
+                return res;
+            }
+            break;
+        default:
+            break;
+    }
+    strip->stripCfg.hold_mode = LL_HOLD_NONE;
     return res;
 }
 
@@ -329,6 +785,8 @@ void led_strip_debug_dump( led_strip_t *strip ) {
         log_printf( "            .with_dma: %d\n", strip->stripCfg.led_chan_config.flags.with_dma );
         log_printf( "            .io_loop_back: %d\n", strip->stripCfg.led_chan_config.flags.io_loop_back );
         log_printf( "            .io_od_mode: %d\n", strip->stripCfg.led_chan_config.flags.io_od_mode );
+        log_printf( "    hold mode: %s\n", strip->stripCfg.hold_mode == LL_HOLD_LOOP ? "hardware loop" :
+                    strip->stripCfg.hold_mode == LL_HOLD_TIMER ? "refresh timer" : "off" );
         log_printf( "    led_tx_config:\n" );
         log_printf( "        .loop_count: %d\n", strip->stripCfg.led_tx_config.loop_count );
         log_printf( "        .flags\n" );
@@ -338,6 +796,19 @@ void led_strip_debug_dump( led_strip_t *strip ) {
         log_printf( "    led_encoder_cfg: %p\n", &strip->stripCfg.led_encoder_cfg );
         log_printf( "    led_encoder: %p\n", strip->stripCfg.led_encoder );
         log_printf( "    led_encoder chunk size: %d\n", strip->stripCfg.led_encoder_cfg.min_chunk_size );
+        log_printf( "    RMT interrupts per frame (est.): %d\n", led_strip_refill_irqs( strip ) );
+        log_printf( "    led_encoder mode: %s\n", ll_encoder_name[ strip->stripCfg.enc_mode ] );
+        if ( strip->stripCfg.sym_lut ) {
+            log_printf( "    led_encoder symbol lut: %p (%d bytes, shared)\n", strip->stripCfg.sym_lut, LL_SYMBOL_LUT_ENTRIES * sizeof( rmt_symbol_word_t ) );
+        }
+        if ( strip->stripCfg.enc_buf ) {
+            log_printf( "    led_encoder staging buf: %p (%d bytes)\n", strip->stripCfg.enc_buf, PIXEL_SIZE( strip ) );
+        }
+        if ( strip->stripCfg.frame_buf ) {
+            log_printf( "    led_encoder frame buf: %p (%d symbols, %d bytes)\n", strip->stripCfg.frame_buf,
+                        strip->stripCfg.frame_symbols, strip->stripCfg.frame_symbols * sizeof( rmt_symbol_word_t ) );
+            log_printf( "    led_encoder frame buf cost: %d bytes per LED\n", COLOR_SIZE( strip ) * 8 * sizeof( rmt_symbol_word_t ) );
+        }
         log_printf( "    -----------------------------------------\n" );
         log_printf( "    led color order: %s\n", col_ord[ led_params[ strip->type ].order ] );
         log_printf( "    led custom color order: %s\n", col_ord[ custom_color_order ] );
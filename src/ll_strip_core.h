@@ -22,7 +22,14 @@
 // Configuration constants
 #define LL_MEM_BLOCK_SIZE_DEFAULT ( ( size_t)SOC_RMT_MEM_WORDS_PER_CHANNEL )  /* Size of memory block if no DMA */
 #define LL_MEM_BLOCK_SIZE_DMA 1024                                             /* Size of memory block with DMA */
-#define LL_ENCODER_MIN_CHUNK_SIZE 64                                           /* Minimum RMT symbol space for encoder */
+#define LL_ENCODER_MIN_CHUNK_SIZE 64                                           /* Largest encoder min_chunk_size used */
+#define LL_MEM_BLOCKS_MAX 4                                                    /* Most memory blocks a non-DMA channel will claim */
+#define LL_RMT_TX_CHANNELS SOC_RMT_TX_CANDIDATES_PER_GROUP                     /* RMT channels able to transmit */
+
+// hold() modes
+#define LL_HOLD_NONE  0     /* Not holding */
+#define LL_HOLD_LOOP  1     /* Held frame replayed by an infinite RMT hardware loop */
+#define LL_HOLD_TIMER 2     /* Held frame re-queued from a periodic esp_timer */
 
 // Utility macros
 #define COLOR_SIZE( strip ) ( 3 + ( (strip)->is_rgbw != 0 ) )
@@ -34,7 +41,11 @@ esp_err_t led_strip_init( led_strip_t *strip );
 // Modify strip configuration for DMA and interrupt priority
 esp_err_t led_strip_init_modify( led_strip_t *strip, ll_dma_t use_dma, ll_priority_t priority );
 
-// Install LED strip and allocate resources (buffer, RMT channel, encoder)
+// Select the RMT led encoder (per-byte or batch callback)
+esp_err_t led_strip_init_encoder( led_strip_t *strip, ll_encoder_t enc_mode );
+
+// Install LED strip and allocate resources (buffer, RMT channel, encoder).
+// On failure everything allocated so far is released again, so there is nothing to free
 esp_err_t led_strip_install( led_strip_t *strip );
 
 // Free all resources used by the strip
@@ -43,6 +54,22 @@ esp_err_t led_strip_free( led_strip_t *strip );
 // Transmit LED buffer data to the strip
 esp_err_t led_strip_flush( led_strip_t *strip );
 
+// Start transmitting LED buffer data to the strip without waiting for it to finish.
+// Waits for the previous frame first, so the encoder buffers are never overwritten in flight
+esp_err_t led_strip_flush_async( led_strip_t *strip );
+
+// Wait up to timeout_ms (-1 = forever) for the frame in flight to finish
+esp_err_t led_strip_wait( led_strip_t *strip, int timeout_ms );
+
+// Encode the LED buffer once and replay it until led_strip_hold_stop() or the next flush
+esp_err_t led_strip_hold( led_strip_t *strip, uint32_t refresh_ms );
+
+// Stop replaying a held frame. Does nothing if the strip is not holding
+esp_err_t led_strip_hold_stop( led_strip_t *strip );
+
+// Estimated number of RMT interrupts needed to send one frame with the current memory block size
+size_t led_strip_refill_irqs( led_strip_t *strip );
+
 // Dump strip configuration for debugging
 void led_strip_debug_dump( led_strip_t *strip );
 
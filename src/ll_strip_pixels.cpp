@@ -6,13 +6,24 @@
 #include "ll_strip_pixels.h"
 #include <string.h>
 
+void led_strip_build_bright_lut( led_strip_t *strip ) {
+    /* Fills the brightness lookup table used by every encoder to scale the LED data */
+    for ( int i = 0; i < 256; i++ ) {
+        strip->bright_lut[ i ] = scale8_video( ( uint8_t )i, strip->brightness );
+    }
+    led_strip_mark_dirty( strip, 0, PIXEL_SIZE( strip ) );
+}
+
 esp_err_t led_strip_set_brightness( led_strip_t *strip, uint8_t num ) {
     /* Sets the intensity of all LED's in the strip */
     if ( !( strip && strip->buf ) ) {
         log_d( "Error: Strip not initialized." );
         return ESP_ERR_INVALID_ARG;
     }
-    strip->brightness = num;
+    if ( strip->brightness != num ) {
+        strip->brightness = num;
+        led_strip_build_bright_lut( strip );
+    }
     return ESP_OK;
 }
 
@@ -34,6 +45,7 @@ esp_err_t led_strip_set_pixel( led_strip_t *strip, size_t num, rgb_t color ) {
 
     color_order_t order = use_custom_color_order ? custom_color_order : led_params[ strip->type ].order;
     size_t idx = num * COLOR_SIZE( strip );
+    led_strip_mark_dirty( strip, idx, COLOR_SIZE( strip ) );
 
     switch ( order ) {
         case ORDER_RGB:
@@ -220,6 +232,7 @@ esp_err_t led_strip_clear( led_strip_t *strip, size_t num_bytes ) {
         return ESP_ERR_INVALID_ARG;
     }
     memset( strip->buf, 0, num_bytes );
+    led_strip_mark_dirty( strip, 0, num_bytes );
     return ESP_OK;
 }
 
@@ -20,6 +20,27 @@
 #include "ll_strip_core.h"
 #include "esp32-hal-log.h"
 
+// Widen the strip's dirty range to cover pixel bytes [first, first + count).
+// LiteLEDpio keeps its encoded frame and re-encodes only the dirty range.
+static inline void led_strip_mark_dirty( led_strip_t *strip, size_t first, size_t count ) {
+    if ( first < strip->dirty_lo ) {
+        strip->dirty_lo = first;
+    }
+    if ( first + count > strip->dirty_hi ) {
+        strip->dirty_hi = first + count;
+    }
+}
+
+// Empty the dirty range once the pixel buffer has been encoded.
+static inline void led_strip_clean( led_strip_t *strip ) {
+    strip->dirty_lo = PIXEL_SIZE( strip );
+    strip->dirty_hi = 0;
+}
+
+// Rebuild the brightness lookup table from the current brightness value.
+// Every encoded byte changes with it, so the whole strip becomes dirty.
+void led_strip_build_bright_lut( led_strip_t *strip );
+
 // Set global brightness for all LEDs (0-255)
 esp_err_t led_strip_set_brightness( led_strip_t *strip, uint8_t num );
 
@@ -0,0 +1,480 @@
+//
+/*
+    LiteLED host tests: fake ESP-IDF drivers - Implementation
+*/
+
+#include "fake_idf.h"
+#include <chrono>
+#include <deque>
+
+fake_state_t fake;
+
+// -------------------------------------------------------------------------
+// Driver state
+// -------------------------------------------------------------------------
+
+typedef struct {
+    bool live;
+    uint8_t width;
+    bool lsb_first;
+    uint32_t clk_hz;
+    size_t queue_depth;
+    parlio_tx_done_callback_t cb;
+    void *ctx;
+    int64_t busy_until;
+    std::deque<size_t> pending;     /* indices into fake.tx, oldest first */
+} fake_unit_t;
+
+struct ll_host_sem {
+    UBaseType_t count;
+    UBaseType_t max;
+    bool mutex;
+};
+
+struct esp_timer {
+    esp_timer_cb_t cb;
+    void *arg;
+    bool armed;
+    int64_t due_us;
+};
+
+#define FAKE_UNITS_MAX 8
+
+static fake_unit_t fake_units[ FAKE_UNITS_MAX ];
+static std::vector<esp_timer *> fake_timers;
+static int fake_locks_held;
+static std::chrono::steady_clock::time_point fake_host_mark = std::chrono::steady_clock::now();
+
+static parlio_tx_unit_handle_t fake_handle( uint8_t unit ) {
+    return ( parlio_tx_unit_handle_t )( uintptr_t )( unit + 1 );
+}
+
+uint8_t fake_unit_index( parlio_tx_unit_handle_t handle ) {
+    return ( uint8_t )( ( uintptr_t )handle - 1 );
+}
+
+// -------------------------------------------------------------------------
+// Virtual time
+// -------------------------------------------------------------------------
+
+// Charge the host CPU time since the last driver call to the virtual clock.
+static void fake_charge_cpu( void ) {
+    auto now = std::chrono::steady_clock::now();
+    if ( fake.cpu_scale > 0 ) {
+        double us = std::chrono::duration<double, std::micro>( now - fake_host_mark ).count();
+        fake.now_us += ( int64_t )( us * fake.cpu_scale );
+    }
+    fake_host_mark = now;
+}
+
+// Time spent inside the fake itself is not charged.
+static void fake_leave( void ) {
+    fake_host_mark = std::chrono::steady_clock::now();
+}
+
+// Earliest pending event: a transfer end, or (timers true) an armed timer.
+static bool fake_next_event( bool timers, int64_t *at ) {
+    bool found = false;
+    for ( uint8_t u = 0; u < FAKE_UNITS_MAX; u++ ) {
+        if ( !fake_units[ u ].pending.empty() ) {
+            int64_t t = fake.tx[ fake_units[ u ].pending.front() ].end_us;
+            if ( !found || t < *at ) {
+                *at   = t;
+                found = true;
+            }
+        }
+    }
+    if ( timers ) {
+        for ( esp_timer *tm : fake_timers ) {
+            if ( tm->armed && ( !found || tm->due_us < *at ) ) {
+                *at   = tm->due_us;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+// Run every done callback, and (timers true) timer, due by now, in time order.
+static void fake_run_due( bool timers ) {
+    int64_t at;
+    while ( fake_next_event( timers, &at ) && at <= fake.now_us ) {
+        for ( uint8_t u = 0; u < FAKE_UNITS_MAX; u++ ) {
+            fake_unit_t *unit = &fake_units[ u ];
+            if ( !unit->pending.empty() && fake.tx[ unit->pending.front() ].end_us == at ) {
+                fake_tx_t *tx = &fake.tx[ unit->pending.front() ];
+                if ( fake.keep_data && memcmp( tx->payload, tx->data.data(), tx->data.size() ) != 0 ) {
+                    fake.overwrites++;
+                }
+                tx->payload = NULL;
+                unit->pending.pop_front();
+                parlio_tx_done_event_data_t edata = {};
+                if ( unit->cb ) {
+                    unit->cb( fake_handle( u ), &edata, unit->ctx );
+                }
+                break;
+            }
+        }
+        if ( timers ) {
+            for ( esp_timer *tm : fake_timers ) {
+                if ( tm->armed && tm->due_us == at ) {
+                    tm->armed = false;
+                    tm->cb( tm->arg );
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Driver call entry: charge CPU time and deliver the done interrupts now due.
+// Timers run in their own task, so they only fire while no lock is held.
+static void fake_enter( void ) {
+    fake_charge_cpu();
+    fake_run_due( fake_locks_held == 0 );
+}
+
+// Block until ready() holds or deadline passes, jumping from one event to the
+// next.  Returns ready().
+template <typename F>
+static bool fake_block( F ready, int64_t deadline ) {
+    while ( !ready() ) {
+        int64_t at;
+        if ( !fake_next_event( fake_locks_held == 0, &at ) || at > deadline ) {
+            if ( deadline != INT64_MAX && deadline > fake.now_us ) {
+                fake.now_us = deadline;
+            }
+            return ready();
+        }
+        if ( at > fake.now_us ) {
+            fake.now_us = at;
+        }
+        fake_run_due( fake_locks_held == 0 );
+    }
+    return true;
+}
+
+void fake_advance( int64_t us ) {
+    fake_charge_cpu();
+    fake.now_us += us;
+    fake_run_due( true );
+    fake_leave();
+}
+
+void fake_reset( void ) {
+    for ( uint8_t u = 0; u < FAKE_UNITS_MAX; u++ ) {
+        fake_units[ u ] = fake_unit_t();
+    }
+    for ( esp_timer *tm : fake_timers ) {
+        tm->armed = false;
+    }
+    fake.tx.clear();
+    fake.cpu_scale  = 0;
+    fake.restart_us = 0;
+    fake.dma_limit  = SIZE_MAX;
+    fake.units_max  = LL_PARLIO_TX_UNITS;
+    fake.keep_data  = true;
+    fake.deadlocks  = 0;
+    fake.overwrites = 0;
+    fake_locks_held = 0;
+    fake_leave();
+}
+
+std::vector<uint8_t> fake_wire( uint8_t unit, size_t first ) {
+    std::vector<uint8_t> out;
+    for ( size_t i = first; i < fake.tx.size(); i++ ) {
+        const fake_tx_t &tx = fake.tx[ i ];
+        if ( tx.unit != unit ) {
+            continue;
+        }
+        if ( !tx.lsb_first ) {
+            out.insert( out.end(), tx.data.begin(), tx.data.end() );
+            continue;
+        }
+        // Reverse the order of the width-bit sample slots in each byte
+        const uint8_t slots = 8 / tx.width;
+        const uint8_t mask  = ( uint8_t )( ( 1 << tx.width ) - 1 );
+        for ( uint8_t v : tx.data ) {
+            uint8_t msb = 0;
+            for ( uint8_t k = 0; k < slots; k++ ) {
+                msb = ( uint8_t )( ( msb << tx.width ) | ( ( v >> ( k * tx.width ) ) & mask ) );
+            }
+            out.push_back( msb );
+        }
+    }
+    return out;
+}
+
+// -------------------------------------------------------------------------
+// Heap, misc
+// -------------------------------------------------------------------------
+
+const char *esp_err_to_name( esp_err_t code ) {
+    switch ( code ) {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+        default:                    return "ESP_FAIL";
+    }
+}
+
+void *heap_caps_calloc( size_t n, size_t size, uint32_t caps ) {
+    if ( ( caps & MALLOC_CAP_DMA ) && n * size > fake.dma_limit ) {
+        return NULL;
+    }
+    // Word aligned like the IDF heap, so the encoders' 32-bit stores are legal
+    void *p = aligned_alloc( 4, ( n * size + 3 ) & ~( size_t )3 );
+    if ( p ) {
+        memset( p, 0, n * size );
+        fake.allocs++;
+    }
+    return p;
+}
+
+void *heap_caps_malloc( size_t size, uint32_t caps ) {
+    return heap_caps_calloc( 1, size, caps );
+}
+
+void heap_caps_free( void *ptr ) {
+    if ( ptr ) {
+        fake.allocs--;
+        free( ptr );
+    }
+}
+
+bool psramFound() {
+    return false;
+}
+
+uint32_t esp_random() {
+    return ( uint32_t )rand();
+}
+
+void delayMicroseconds( uint32_t us ) {
+    fake_charge_cpu();
+    fake_block( [] { return false; }, fake.now_us + us );
+    fake_leave();
+}
+
+TickType_t xTaskGetTickCount() {
+    return ( TickType_t )( fake.now_us / 1000 );
+}
+
+UBaseType_t uxTaskPriorityGet( TaskHandle_t task ) {
+    return 1;
+}
+
+void vTaskPrioritySet( TaskHandle_t task, UBaseType_t prio ) {
+}
+
+// -------------------------------------------------------------------------
+// Semaphores
+// -------------------------------------------------------------------------
+
+SemaphoreHandle_t xSemaphoreCreateCounting( UBaseType_t max_count, UBaseType_t initial_count ) {
+    return new ll_host_sem { initial_count, max_count, false };
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return new ll_host_sem { 0, 1, false };
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new ll_host_sem { 1, 1, true };
+}
+
+BaseType_t xSemaphoreTake( SemaphoreHandle_t sem, TickType_t ticks ) {
+    fake_enter();
+    int64_t deadline = ( ticks == portMAX_DELAY ) ? INT64_MAX : fake.now_us + ( int64_t )ticks * 1000;
+    bool    ok       = ( ticks == 0 ) ? sem->count > 0 : fake_block( [ sem ] { return sem->count > 0; }, deadline );
+    if ( ok ) {
+        sem->count--;
+        fake_locks_held += sem->mutex;
+    }
+    else if ( ticks == portMAX_DELAY ) {
+        fake.deadlocks++;   // nothing left that could ever give it
+    }
+    fake_leave();
+    return ok ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xSemaphoreGive( SemaphoreHandle_t sem ) {
+    if ( sem->count >= sem->max ) {
+        return pdFALSE;
+    }
+    sem->count++;
+    fake_locks_held -= sem->mutex;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR( SemaphoreHandle_t sem, BaseType_t *woken ) {
+    *woken = pdFALSE;
+    return xSemaphoreGive( sem );
+}
+
+void vSemaphoreDelete( SemaphoreHandle_t sem ) {
+    delete sem;
+}
+
+// -------------------------------------------------------------------------
+// esp_timer
+// -------------------------------------------------------------------------
+
+esp_err_t esp_timer_create( const esp_timer_create_args_t *args, esp_timer_handle_t *out ) {
+    esp_timer *tm = new esp_timer { args->callback, args->arg, false, 0 };
+    fake_timers.push_back( tm );
+    *out = tm;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once( esp_timer_handle_t timer, uint64_t timeout_us ) {
+    if ( timer->armed ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed  = true;
+    timer->due_us = fake.now_us + ( int64_t )timeout_us;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic( esp_timer_handle_t timer, uint64_t period_us ) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_timer_stop( esp_timer_handle_t timer ) {
+    if ( !timer->armed ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete( esp_timer_handle_t timer ) {
+    for ( size_t i = 0; i < fake_timers.size(); i++ ) {
+        if ( fake_timers[ i ] == timer ) {
+            fake_timers.erase( fake_timers.begin() + i );
+            break;
+        }
+    }
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+    fake_enter();
+    fake_leave();
+    return fake.now_us;
+}
+
+// -------------------------------------------------------------------------
+// PARLIO TX
+// -------------------------------------------------------------------------
+
+esp_err_t parlio_new_tx_unit( const parlio_tx_unit_config_t *config, parlio_tx_unit_handle_t *ret_unit ) {
+    uint8_t in_use = 0;
+    for ( uint8_t u = 0; u < FAKE_UNITS_MAX; u++ ) {
+        in_use += fake_units[ u ].live;
+    }
+    if ( in_use >= fake.units_max ) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    for ( uint8_t u = 0; u < FAKE_UNITS_MAX; u++ ) {
+        if ( !fake_units[ u ].live ) {
+            fake_units[ u ]             = fake_unit_t();
+            fake_units[ u ].live        = true;
+            fake_units[ u ].width       = ( uint8_t )config->data_width;
+            fake_units[ u ].lsb_first   = config->data_width < 8 && config->bit_pack_order == PARLIO_BIT_PACK_ORDER_LSB;
+            fake_units[ u ].clk_hz      = config->output_clk_freq_hz;
+            fake_units[ u ].queue_depth = config->trans_queue_depth ? config->trans_queue_depth : 1;
+            *ret_unit = fake_handle( u );
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t parlio_del_tx_unit( parlio_tx_unit_handle_t unit ) {
+    fake_unit_t *u = &fake_units[ fake_unit_index( unit ) ];
+    if ( !u->pending.empty() ) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    u->live = false;
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_enable( parlio_tx_unit_handle_t unit ) {
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_disable( parlio_tx_unit_handle_t unit ) {
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_register_event_callbacks( parlio_tx_unit_handle_t unit,
+                                                   const parlio_tx_event_callbacks_t *cbs, void *user_data ) {
+    fake_unit_t *u = &fake_units[ fake_unit_index( unit ) ];
+    u->cb  = cbs->on_trans_done;
+    u->ctx = user_data;
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_transmit( parlio_tx_unit_handle_t unit, const void *payload, size_t payload_bits,
+                                   const parlio_transmit_config_t *config ) {
+    fake_enter();
+    const uint8_t index = fake_unit_index( unit );
+    fake_unit_t  *u     = &fake_units[ index ];
+
+    // A full queue blocks the caller until the oldest transfer is done
+    fake_block( [ u ] { return u->pending.size() < u->queue_depth; }, INT64_MAX );
+
+    fake_tx_t tx;
+    tx.unit      = index;
+    tx.width     = u->width;
+    tx.lsb_first = u->lsb_first;
+    tx.queued_us = fake.now_us;
+    tx.start_us  = ( u->busy_until > fake.now_us ) ? u->busy_until + fake.restart_us : fake.now_us;
+    tx.end_us    = tx.start_us + ( int64_t )( payload_bits / u->width ) * 1000000 / u->clk_hz;
+    tx.payload   = ( const uint8_t * )payload;
+    if ( fake.keep_data ) {
+        tx.data.assign( ( const uint8_t * )payload, ( const uint8_t * )payload + payload_bits / 8 );
+    }
+    u->busy_until = tx.end_us;
+    u->pending.push_back( fake.tx.size() );
+    fake.tx.push_back( tx );
+    fake_leave();
+    return ESP_OK;
+}
+
+esp_err_t parlio_tx_unit_wait_all_done( parlio_tx_unit_handle_t unit, int timeout_ms ) {
+    fake_enter();
+    fake_unit_t *u        = &fake_units[ fake_unit_index( unit ) ];
+    int64_t      deadline = ( timeout_ms < 0 ) ? INT64_MAX : fake.now_us + ( int64_t )timeout_ms * 1000;
+    bool         done     = fake_block( [ u ] { return u->pending.empty(); }, deadline );
+    fake_leave();
+    return done ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+// -------------------------------------------------------------------------
+// RMT (the tests drive the encoder callbacks directly)
+// -------------------------------------------------------------------------
+
+esp_err_t rmt_new_bytes_encoder( const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder ) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t rmt_new_copy_encoder( const rmt_copy_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder ) {
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t rmt_del_encoder( rmt_encoder_handle_t encoder ) {
+    return ESP_OK;
+}
+
+esp_err_t rmt_encoder_reset( rmt_encoder_handle_t encoder ) {
+    return ESP_OK;
+}
+
+//  --- EOF --- //
@@ -0,0 +1,73 @@
+//
+/*
+    LiteLED host tests: fake ESP-IDF drivers
+
+    Single-threaded stand-ins for the heap, FreeRTOS semaphores, esp_timer and the PARLIO TX
+    driver, enough to run ll_parlio_core.cpp, ll_strip_pixels.cpp and the RMT encoder sources
+    on a desktop.
+
+    Time is virtual. It only moves when the code under test waits (delayMicroseconds(),
+    a blocking semaphore take, parlio_tx_unit_wait_all_done()) or, with fake.cpu_scale set,
+    by the host CPU time spent between two driver calls multiplied by cpu_scale, which models
+    the slower target CPU.
+
+    Each PARLIO transmit is recorded with its bytes and wire timing. A transfer occupies the
+    wire for payload_bits / data_width clocks at the unit's output clock, starting when it is
+    queued or, if the previous transfer of the same unit is still on the wire, fake.restart_us
+    after that one ends: the time the driver takes to start the next queued transaction, with
+    the line idling LOW meanwhile. Its done callback runs once virtual time passes its end, at
+    the next driver call, as the TX done ISR would. A transfer whose DMA buffer changed
+    between queue time and its end is counted in fake.overwrites: the code under test wrote
+    to a buffer the DMA was still reading.
+*/
+
+#ifndef __LL_FAKE_IDF_H__
+#define __LL_FAKE_IDF_H__
+
+#include "LiteLED.h"
+#include <vector>
+
+// One parlio_tx_unit_transmit() call
+typedef struct {
+    uint8_t unit;                   /* TX unit index, in creation order */
+    uint8_t width;                  /* data_width of the unit */
+    bool lsb_first;                 /* below 8 lines with PARLIO_BIT_PACK_ORDER_LSB: first sample in the low bits */
+    std::vector<uint8_t> data;      /* payload bytes at queue time (empty unless fake.keep_data) */
+    const uint8_t *payload;         /* the DMA buffer itself, valid until the transfer is done */
+    int64_t queued_us;              /* virtual time of the transmit call */
+    int64_t start_us;               /* first bit on the wire */
+    int64_t end_us;                 /* last bit on the wire; the done callback runs after this */
+} fake_tx_t;
+
+typedef struct {
+    int64_t now_us;                 /* virtual time */
+    double cpu_scale;               /* host CPU time to virtual time factor (0 = CPU time is free) */
+    int64_t restart_us;             /* LOW gap before a transfer queued behind another starts (0 = none) */
+    size_t dma_limit;               /* DMA allocations larger than this fail */
+    uint8_t units_max;              /* TX units parlio_new_tx_unit() hands out */
+    bool keep_data;                 /* record transfer payloads in tx */
+    std::vector<fake_tx_t> tx;      /* every transfer since fake_reset() */
+    size_t allocs;                  /* heap blocks currently allocated */
+    size_t deadlocks;               /* blocking takes that could never succeed */
+    size_t overwrites;              /* transfers whose buffer changed while it was on the wire */
+} fake_state_t;
+
+extern fake_state_t fake;
+
+// Drop all driver state and recorded transfers; frees nothing the code under test holds
+void fake_reset( void );
+
+// Advance virtual time by us, running every done callback and timer that falls due
+void fake_advance( int64_t us );
+
+// Bytes of every recorded transfer of unit since transfer first, concatenated, as MSB-first
+// packing (PARLIO_BIT_PACK_ORDER_MSB) whatever order the unit was created with, so the
+// samples read back in the order they left the pins
+std::vector<uint8_t> fake_wire( uint8_t unit = 0, size_t first = 0 );
+
+// Index of a TX unit handle, in creation order
+uint8_t fake_unit_index( parlio_tx_unit_handle_t handle );
+
+#endif /* __LL_FAKE_IDF_H__ */
+
+//  --- EOF --- //
@@ -0,0 +1,20 @@
+//
+/*
+    LiteLED host tests: PARLIO helpers - Implementation
+*/
+
+#include "host_test.h"
+#include "ll_parlio_core.h"
+
+esp_err_t host_group_install( parlio_group_cfg_t *cfg, const host_lane_t *lanes, size_t count ) {
+    *cfg = parlio_group_cfg_t();
+    for ( size_t i = 0; i < count; i++ ) {
+        parlio_lane_t *lane = &cfg->lanes[ lanes[ i ].lane ];
+        host_strip_setup( &lane->strip, lanes[ i ].type, lanes[ i ].length, lanes[ i ].rgbw, lanes[ i ].lane );
+        lane->assigned = true;
+    }
+    cfg->lane_count = ( uint8_t )count;
+    return parlio_group_install( cfg );
+}
+
+//  --- EOF --- //
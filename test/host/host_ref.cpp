@@ -0,0 +1,133 @@
+//
+/*
+    LiteLED host tests: reference encoders - Implementation
+*/
+
+#include "host_ref.h"
+
+static size_t ref_pixel_bytes( const led_strip_t *strip ) {
+    return strip->length * ( 3 + ( strip->is_rgbw != 0 ) );
+}
+
+std::vector<uint8_t> ref_lane_samples( const led_strip_t *strip, size_t frame_bytes ) {
+    const parlio_led_params_t *p   = &parlio_led_params[ strip->type ];
+    const int                  spb = p->samples_per_bit;
+    std::vector<uint8_t>       samples( frame_bytes * 8 * spb, 0 );
+    const size_t               bytes = ref_pixel_bytes( strip );
+
+    for ( size_t b = 0; b < bytes && b < frame_bytes; b++ ) {
+        uint8_t val = strip->bright_lut[ strip->buf[ b ] ];
+        for ( int bit = 0; bit < 8; bit++ ) {
+            uint8_t pat = ( ( val >> ( 7 - bit ) ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+            for ( int s = 0; s < spb; s++ ) {
+                samples[ ( b * 8 + bit ) * spb + s ] = ( pat >> ( spb - 1 - s ) ) & 1;
+            }
+        }
+    }
+    return samples;
+}
+
+std::vector<uint8_t> ref_wire_samples( const std::vector<uint8_t> &wire, uint8_t width, uint8_t line ) {
+    std::vector<uint8_t> samples;
+    if ( width == 16 ) {
+        for ( size_t i = 0; i + 1 < wire.size(); i += 2 ) {
+            uint16_t v = ( uint16_t )( wire[ i ] | ( wire[ i + 1 ] << 8 ) );
+            samples.push_back( ( v >> line ) & 1 );
+        }
+        return samples;
+    }
+    const int per_byte = 8 / width;
+    for ( uint8_t v : wire ) {
+        for ( int k = 0; k < per_byte; k++ ) {
+            samples.push_back( ( v >> ( 8 - width * ( k + 1 ) + line ) ) & 1 );
+        }
+    }
+    return samples;
+}
+
+std::vector<uint8_t> ref_strip_bytes( const led_strip_t *strip ) {
+    return ref_lane_samples( strip, ref_pixel_bytes( strip ) );
+}
+
+std::vector<uint8_t> ref_strip_packed( const led_strip_t *strip ) {
+    std::vector<uint8_t> samples = ref_strip_bytes( strip );
+    std::vector<uint8_t> packed( samples.size() / 8, 0 );
+    for ( size_t t = 0; t < samples.size(); t++ ) {
+        packed[ t / 8 ] |= ( uint8_t )( samples[ t ] << ( 7 - t % 8 ) );
+    }
+    return packed;
+}
+
+std::vector<uint8_t> ref_group_or( const parlio_group_cfg_t *cfg ) {
+    const uint8_t width    = cfg->data_width;
+    const uint8_t per_byte = ( width < 8 ) ? 8 / width : 1;
+
+    uint8_t lead        = 0;
+    size_t  frame_bytes = 0;
+    for ( uint8_t n = PARLIO_TX_UNIT_MAX_DATA_WIDTH; n-- > 0; ) {
+        if ( cfg->lanes[ n ].assigned ) {
+            lead = n;
+            if ( ref_pixel_bytes( &cfg->lanes[ n ].strip ) > frame_bytes ) {
+                frame_bytes = ref_pixel_bytes( &cfg->lanes[ n ].strip );
+            }
+        }
+    }
+    const int    spb         = parlio_led_params[ cfg->lanes[ lead ].strip.type ].samples_per_bit;
+    const size_t block_bytes = ( size_t )spb * width;
+
+    std::vector<uint8_t> out( frame_bytes * block_bytes, 0 );
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( !cfg->lanes[ n ].assigned ) {
+            continue;
+        }
+        const led_strip_t         *strip = &cfg->lanes[ n ].strip;
+        const parlio_led_params_t *p     = &parlio_led_params[ strip->type ];
+        for ( size_t b = 0; b < ref_pixel_bytes( strip ); b++ ) {
+            uint8_t  val = strip->bright_lut[ strip->buf[ b ] ];
+            uint8_t *dst = &out[ b * block_bytes ];
+            for ( int bit = 0; bit < 8; bit++ ) {
+                uint8_t pat = ( ( val >> ( 7 - bit ) ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+                for ( int s = 0; s < spb; s++ ) {
+                    if ( !( ( pat >> ( spb - 1 - s ) ) & 1 ) ) {
+                        continue;
+                    }
+                    size_t t = ( size_t )bit * spb + s;
+                    if ( width == 16 ) {
+                        dst[ t * 2 + ( n >> 3 ) ] |= ( uint8_t )( 1 << ( n & 7 ) );
+                    }
+                    else {
+                        dst[ t / per_byte ] |= ( uint8_t )( 1 << ( 8 - width * ( t % per_byte + 1 ) + n ) );
+                    }
+                }
+            }
+        }
+    }
+    return out;
+}
+
+bool ref_frame_matches( const std::vector<uint8_t> &wire, const std::vector<uint8_t> &ref ) {
+    if ( wire.size() < ref.size() || wire.size() - ref.size() > 3 ) {
+        return false;
+    }
+    for ( size_t i = 0; i < wire.size(); i++ ) {
+        if ( wire[ i ] != ( ( i < ref.size() ) ? ref[ i ] : 0 ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint32_t> ref_rmt_symbols( const led_strip_t *strip ) {
+    const led_params_t   *p = &led_params[ strip->type ];
+    std::vector<uint32_t> symbols;
+    for ( size_t b = 0; b < ref_pixel_bytes( strip ); b++ ) {
+        uint8_t val = strip->bright_lut[ strip->buf[ b ] ];
+        for ( int bit = 7; bit >= 0; bit-- ) {
+            symbols.push_back( ( ( val >> bit ) & 1 ) ? p->led_1.val : p->led_0.val );
+        }
+    }
+    symbols.push_back( p->led_reset.val );
+    return symbols;
+}
+
+//  --- EOF --- //
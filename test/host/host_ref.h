@@ -0,0 +1,43 @@
+//
+/*
+    LiteLED host tests: reference encoders
+
+    Straightforward bit-by-bit encoders built only from the timing tables in
+    ll_led_timings.h. The optimised encoders in src/ must produce exactly their output.
+*/
+
+#ifndef __LL_HOST_REF_H__
+#define __LL_HOST_REF_H__
+
+#include "LiteLED.h"
+#include "ll_led_timings.h"
+#include <vector>
+
+// PARLIO samples (one 0 / 1 entry per output clock) of a strip's brightness scaled pixels,
+// padded with idle LOW samples to frame_bytes LED bytes
+std::vector<uint8_t> ref_lane_samples( const led_strip_t *strip, size_t frame_bytes );
+
+// Samples of data line `line` in a DMA byte stream of a TX unit `width` lines wide
+// (MSB-first packing below 8 lines, little-endian 16-bit samples at 16)
+std::vector<uint8_t> ref_wire_samples( const std::vector<uint8_t> &wire, uint8_t width, uint8_t line );
+
+// Single strip, data_width 8: the original per-bit encoder, one DMA byte (0 or 1) per sample
+std::vector<uint8_t> ref_strip_bytes( const led_strip_t *strip );
+
+// Single strip, data_width 1: eight samples per DMA byte, first sample in the MSB
+std::vector<uint8_t> ref_strip_packed( const led_strip_t *strip );
+
+// A whole group frame as the pre-transpose encoder built it: zero the buffer, then OR each
+// lane's bits in, lane by lane and byte by byte
+std::vector<uint8_t> ref_group_or( const parlio_group_cfg_t *cfg );
+
+// True if a transmitted frame is ref followed only by the zero padding that word aligns the
+// DMA buffer (whole frames) or by nothing (streamed frames)
+bool ref_frame_matches( const std::vector<uint8_t> &wire, const std::vector<uint8_t> &ref );
+
+// RMT: the symbols of one frame (8 per brightness scaled byte, MSB first) plus the reset
+std::vector<uint32_t> ref_rmt_symbols( const led_strip_t *strip );
+
+#endif /* __LL_HOST_REF_H__ */
+
+//  --- EOF --- //
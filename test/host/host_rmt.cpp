@@ -0,0 +1,57 @@
+//
+/*
+    LiteLED host tests: RMT helpers - Implementation
+*/
+
+#include "host_test.h"
+#include "ll_encoder.h"
+
+void host_rmt_setup( led_strip_t *strip, uint8_t type, size_t length, bool rgbw ) {
+    host_strip_setup( strip, type, length, rgbw );
+    strip->buf                = ( uint8_t * )heap_caps_calloc( 1, host_pixel_bytes( strip ), MALLOC_CAP_INTERNAL );
+    strip->stripCfg.sym_lut   = ll_symbol_lut_acquire( type );
+    strip->stripCfg.reset_sym = led_params[ type ].led_reset;
+    strip->stripCfg.enc_pos   = 0;
+    led_strip_build_bright_lut( strip );
+}
+
+void host_rmt_free( led_strip_t *strip ) {
+    ll_symbol_lut_release( strip->type );
+    heap_caps_free( strip->buf );
+    strip->stripCfg.sym_lut = NULL;
+    strip->buf              = NULL;
+}
+
+size_t host_rmt_frame( rmt_encode_simple_cb_t cb, led_strip_t *strip, size_t mem_symbols,
+                       std::vector<uint32_t> *out ) {
+    std::vector<rmt_symbol_word_t> mem( mem_symbols );
+    size_t calls   = 0;
+    size_t written = 0;
+    size_t space   = mem_symbols;
+    bool   done    = false;
+
+    while ( !done ) {
+        size_t used = 0;
+        while ( !done && used < space ) {
+            size_t n = cb( strip->buf, host_pixel_bytes( strip ), written, space - used, &mem[ used ], &done, strip );
+            calls++;
+            if ( n == 0 ) {
+                break;
+            }
+            if ( out ) {
+                for ( size_t i = 0; i < n; i++ ) {
+                    out->push_back( mem[ used + i ].val );
+                }
+            }
+            used    += n;
+            written += n;
+        }
+        if ( ( used == 0 && !done ) || written > host_pixel_bytes( strip ) * 8 + 1 ) {
+            break;      // stuck, or running past the end of the frame
+        }
+        space = mem_symbols / 2;
+    }
+    return calls;
+}
+
+//  --- EOF --- //
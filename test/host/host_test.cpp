@@ -0,0 +1,47 @@
+//
+/*
+    LiteLED host tests: shared helpers - Implementation
+*/
+
+#include "host_test.h"
+
+int host_checks   = 0;
+int host_failures = 0;
+
+int host_finish( const char *name ) {
+    if ( fake.deadlocks ) {
+        printf( "FAIL %s: %u blocking waits could never return\n", name, ( unsigned )fake.deadlocks );
+        host_failures++;
+    }
+    if ( fake.overwrites ) {
+        printf( "FAIL %s: %u transfers had their buffer changed while on the wire\n", name, ( unsigned )fake.overwrites );
+        host_failures++;
+    }
+    printf( "%s: %d checks, %d failed\n", name, host_checks, host_failures );
+    return host_failures ? 1 : 0;
+}
+
+void host_strip_setup( led_strip_t *strip, uint8_t type, size_t length, bool rgbw, uint8_t gpio ) {
+    *strip            = led_strip_t();
+    strip->type       = type;
+    strip->length     = length;
+    strip->is_rgbw    = rgbw;
+    strip->gpio       = gpio;
+    strip->brightness = 255;
+    strip->bright_act = 255;
+}
+
+void host_scribble( led_strip_t *strip, size_t count ) {
+    for ( size_t i = 0; i < count; i++ ) {
+        led_strip_set_pixel( strip, ( size_t )rand() % strip->length, rgb_from_code( ( uint32_t )rand() & 0xFFFFFF ) );
+    }
+}
+
+void host_fill_sparse( led_strip_t *strip, size_t gap ) {
+    led_strip_clear( strip, host_pixel_bytes( strip ) );
+    for ( size_t i = ( size_t )rand() % gap; i < strip->length; i += gap ) {
+        led_strip_set_pixel( strip, i, rgb_from_code( ( uint32_t )rand() & 0xFFFFFF ) );
+    }
+}
+
+//  --- EOF --- //
@@ -0,0 +1,90 @@
+//
+/*
+    LiteLED host tests: checks, timing and strip setup shared by the test programs
+
+    Each test program is one ctest. HOST_CHECK() records a failure and keeps going;
+    host_finish() prints the tally and gives main() its exit code. Benchmarks print their
+    figures on stdout (ctest --verbose shows them) and only fail on wrong output.
+*/
+
+#ifndef __LL_HOST_TEST_H__
+#define __LL_HOST_TEST_H__
+
+#include "fake_idf.h"
+#include "ll_strip_pixels.h"
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+
+extern int host_checks;
+extern int host_failures;
+
+#define HOST_CHECK( cond ) host_check( ( cond ), #cond, __FILE__, __LINE__ )
+
+static inline bool host_check( bool ok, const char *what, const char *file, int line ) {
+    host_checks++;
+    if ( !ok ) {
+        host_failures++;
+        if ( host_failures <= 20 ) {
+            printf( "FAIL %s:%d: %s\n", file, line, what );
+        }
+    }
+    return ok;
+}
+
+// Print the tally; returns the exit code for main()
+int host_finish( const char *name );
+
+// Average wall time of one call of fn, in microseconds, over iters calls
+template <typename F>
+static double host_time_us( int iters, F fn ) {
+    auto t0 = std::chrono::steady_clock::now();
+    for ( int i = 0; i < iters; i++ ) {
+        fn();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>( t1 - t0 ).count() / iters;
+}
+
+// Set up a strip the way LiteLEDpio::begin() does before parlio_strip_init()
+void host_strip_setup( led_strip_t *strip, uint8_t type, size_t length, bool rgbw = false, uint8_t gpio = 0 );
+
+// One lane of a test group: lane (data line) index and its strip
+typedef struct {
+    uint8_t lane;
+    uint8_t type;
+    size_t length;
+    bool rgbw;
+} host_lane_t;
+
+// Assign lanes and install the group, as LiteLEDpioGroup::addStrip() / begin() do
+esp_err_t host_group_install( parlio_group_cfg_t *cfg, const host_lane_t *lanes, size_t count );
+
+// Pixel bytes of a strip (length x colour size)
+static inline size_t host_pixel_bytes( const led_strip_t *strip ) {
+    return strip->length * ( 3 + ( strip->is_rgbw != 0 ) );
+}
+
+// RMT: set up a strip the way led_strip_init() / led_strip_install() do for the callback
+// encoders: pixel buffer, brightness table, shared symbol table and reset symbol
+void host_rmt_setup( led_strip_t *strip, uint8_t type, size_t length, bool rgbw = false );
+
+// Release what host_rmt_setup() allocated
+void host_rmt_free( led_strip_t *strip );
+
+// Send one frame through a simple encoder callback the way the RMT driver feeds its memory:
+// the whole block of mem_symbols first, then half of it at each threshold interrupt, calling
+// the callback until it returns 0 or sets done. Appends the symbols to out if given and
+// returns the number of callback calls.
+size_t host_rmt_frame( rmt_encode_simple_cb_t cb, led_strip_t *strip, size_t mem_symbols,
+                       std::vector<uint32_t> *out );
+
+// Set count random pixels through the pixel API, so the dirty range is tracked
+void host_scribble( led_strip_t *strip, size_t count );
+
+// Fill a strip with a sparse effect: about one lit pixel in gap, the rest black
+void host_fill_sparse( led_strip_t *strip, size_t gap );
+
+#endif /* __LL_HOST_TEST_H__ */
+
+//  --- EOF --- //
@@ -0,0 +1,92 @@
+//
+/*
+    LiteLED host test stub: the parts of Arduino-ESP32 / ESP-IDF that the encoder and
+    PARLIO core sources use, declared for a desktop compiler. Capabilities match an
+    ESP32-C6 (RMT with DMA, one PARLIO TX unit with 16 data lines). Build with
+    -DSOC_PARLIO_TX_UNITS_PER_GROUP=n to model a chip with several TX units.
+
+    The functions are implemented by the fake driver in ../fake_idf.cpp.
+*/
+
+#ifndef __LL_HOST_ARDUINO_H__
+#define __LL_HOST_ARDUINO_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define ARDUINO_ARCH_ESP32 1
+#define ESP_ARDUINO_VERSION_VAL( a, b, c ) ( ( a ) * 10000 + ( b ) * 100 + ( c ) )
+#define ESP_ARDUINO_VERSION ESP_ARDUINO_VERSION_VAL( 3, 1, 0 )
+#define ESP_IDF_VERSION_VAL( a, b, c ) ( ( a ) * 10000 + ( b ) * 100 + ( c ) )
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL( 5, 4, 0 )
+
+// SoC capabilities (ESP32-C6)
+#define SOC_RMT_SUPPORTED 1
+#define SOC_RMT_SUPPORT_DMA 1
+#define SOC_RMT_TX_CANDIDATES_PER_GROUP 2
+#define SOC_RMT_MEM_WORDS_PER_CHANNEL 48
+#define SOC_PARLIO_SUPPORTED 1
+#define SOC_PARLIO_GROUPS 1
+#ifndef SOC_PARLIO_TX_UNITS_PER_GROUP
+    #define SOC_PARLIO_TX_UNITS_PER_GROUP 1
+#endif
+#define PARLIO_TX_UNIT_MAX_DATA_WIDTH 16
+#define SOC_GPIO_PIN_COUNT 31
+#define GPIO_NUM_MAX 31
+#define GPIO_NUM_NC -1
+#define CONFIG_SPIRAM 1
+#define IRAM_ATTR
+
+// esp_err_t
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NOT_SUPPORTED 0x106
+#define ESP_ERR_TIMEOUT 0x107
+const char *esp_err_to_name( esp_err_t code );
+
+// Heap
+#define MALLOC_CAP_DMA 1
+#define MALLOC_CAP_INTERNAL 2
+#define MALLOC_CAP_SPIRAM 4
+#define MALLOC_CAP_8BIT 8
+void *heap_caps_calloc( size_t n, size_t size, uint32_t caps );
+void *heap_caps_malloc( size_t size, uint32_t caps );
+void heap_caps_free( void *ptr );
+bool psramFound();
+
+// FreeRTOS types
+typedef int gpio_num_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef unsigned TickType_t;
+typedef void *TaskHandle_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS( ms ) ( ms )
+#define configMAX_PRIORITIES 25
+TickType_t xTaskGetTickCount();
+UBaseType_t uxTaskPriorityGet( TaskHandle_t task );
+void vTaskPrioritySet( TaskHandle_t task, UBaseType_t prio );
+
+// Misc
+#define __containerof( ptr, type, member ) ( ( type * )( ( char * )( ptr ) - offsetof( type, member ) ) )
+uint32_t esp_random();
+void delayMicroseconds( uint32_t us );
+
+#include "esp32-hal-log.h"
+#include "freertos/semphr.h"
+
+#endif /* __LL_HOST_ARDUINO_H__ */
+
+//  --- EOF --- //
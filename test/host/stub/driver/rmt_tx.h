@@ -0,0 +1,98 @@
+//
+/*
+    LiteLED host test stub: RMT TX driver (ESP-IDF 5.x API subset). The host tests call
+    the encoder callbacks directly, so the driver functions themselves only fail.
+*/
+
+#ifndef __LL_HOST_RMT_TX_H__
+#define __LL_HOST_RMT_TX_H__
+
+typedef struct rmt_channel_t *rmt_channel_handle_t;
+
+typedef union {
+    struct {
+        uint16_t duration0 : 15;
+        uint16_t level0 : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+typedef enum {
+    RMT_ENCODING_RESET = 0,
+    RMT_ENCODING_COMPLETE = 1,
+    RMT_ENCODING_MEM_FULL = 2
+} rmt_encode_state_t;
+
+typedef struct rmt_encoder_t rmt_encoder_t;
+typedef rmt_encoder_t *rmt_encoder_handle_t;
+struct rmt_encoder_t {
+    size_t ( *encode )( rmt_encoder_t *encoder, rmt_channel_handle_t channel, const void *data,
+                        size_t data_size, rmt_encode_state_t *ret_state );
+    esp_err_t ( *reset )( rmt_encoder_t *encoder );
+    esp_err_t ( *del )( rmt_encoder_t *encoder );
+};
+
+typedef enum { RMT_CLK_SRC_DEFAULT } rmt_clock_source_t;
+typedef struct {
+    gpio_num_t gpio_num;
+    rmt_clock_source_t clk_src;
+    uint32_t resolution_hz;
+    size_t mem_block_symbols;
+    size_t trans_queue_depth;
+    int intr_priority;
+    struct {
+        uint32_t invert_out : 1;
+        uint32_t with_dma : 1;
+        uint32_t io_loop_back : 1;
+        uint32_t io_od_mode : 1;
+        uint32_t allow_pd : 1;
+    } flags;
+} rmt_tx_channel_config_t;
+
+typedef struct {
+    int loop_count;
+    struct {
+        uint32_t eot_level : 1;
+        uint32_t queue_nonblocking : 1;
+    } flags;
+} rmt_transmit_config_t;
+
+typedef struct {
+    rmt_symbol_word_t bit0;
+    rmt_symbol_word_t bit1;
+    struct {
+        uint32_t msb_first : 1;
+    } flags;
+} rmt_bytes_encoder_config_t;
+
+typedef struct {} rmt_copy_encoder_config_t;
+
+typedef size_t ( *rmt_encode_simple_cb_t )( const void *data, size_t data_size, size_t symbols_written,
+                                            size_t symbols_free, rmt_symbol_word_t *symbols, bool *done, void *arg );
+typedef struct {
+    rmt_encode_simple_cb_t callback;
+    void *arg;
+    size_t min_chunk_size;
+} rmt_simple_encoder_config_t;
+
+typedef struct {
+    size_t num_symbols;
+} rmt_tx_done_event_data_t;
+typedef bool ( *rmt_tx_done_callback_t )( rmt_channel_handle_t tx_chan, const rmt_tx_done_event_data_t *edata,
+                                          void *user_ctx );
+typedef struct {
+    rmt_tx_done_callback_t on_trans_done;
+} rmt_tx_event_callbacks_t;
+
+#define RMT_MEM_ALLOC_CAPS MALLOC_CAP_INTERNAL
+
+esp_err_t rmt_new_bytes_encoder( const rmt_bytes_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder );
+esp_err_t rmt_new_copy_encoder( const rmt_copy_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder );
+esp_err_t rmt_del_encoder( rmt_encoder_handle_t encoder );
+esp_err_t rmt_encoder_reset( rmt_encoder_handle_t encoder );
+
+#endif /* __LL_HOST_RMT_TX_H__ */
+
+//  --- EOF --- //
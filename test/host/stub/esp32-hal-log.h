@@ -0,0 +1,24 @@
+//
+/*
+    LiteLED host test stub: logging. Silent unless built with -DLL_HOST_LOG.
+*/
+
+#ifndef __LL_HOST_LOG_H__
+#define __LL_HOST_LOG_H__
+
+#include <stdio.h>
+
+#ifdef LL_HOST_LOG
+    #define log_printf( ... ) printf( __VA_ARGS__ )
+#else
+    #define log_printf( ... ) ( ( void )0 )
+#endif
+#define log_e( ... ) log_printf( __VA_ARGS__ )
+#define log_w( ... ) log_printf( __VA_ARGS__ )
+#define log_i( ... ) log_printf( __VA_ARGS__ )
+#define log_d( ... ) log_printf( __VA_ARGS__ )
+#define log_v( ... ) log_printf( __VA_ARGS__ )
+
+#endif /* __LL_HOST_LOG_H__ */
+
+//  --- EOF --- //
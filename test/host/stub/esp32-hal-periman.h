@@ -0,0 +1,21 @@
+//
+/*
+    LiteLED host test stub: Peripheral Manager types referenced by LiteLED.h.
+*/
+
+#ifndef __LL_HOST_PERIMAN_H__
+#define __LL_HOST_PERIMAN_H__
+
+typedef enum {
+    ESP32_BUS_TYPE_INIT,
+    ESP32_BUS_TYPE_GPIO,
+    ESP32_BUS_TYPE_RMT_TX,
+    ESP32_BUS_TYPE_RMT_RX,
+    ESP32_BUS_TYPE_MAX
+} peripheral_bus_type_t;
+
+typedef bool ( *peripheral_bus_deinit_cb_t )( void *bus );
+
+#endif /* __LL_HOST_PERIMAN_H__ */
+
+//  --- EOF --- //
@@ -0,0 +1,24 @@
+//
+/*
+    LiteLED host test stub: FreeRTOS semaphores. The host tests are
+    single threaded; a take that would block runs the fake driver's pending events instead.
+*/
+
+#ifndef __LL_HOST_SEMPHR_H__
+#define __LL_HOST_SEMPHR_H__
+
+typedef struct ll_host_sem *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateCounting( UBaseType_t max_count, UBaseType_t initial_count );
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake( SemaphoreHandle_t sem, TickType_t ticks );
+BaseType_t xSemaphoreGive( SemaphoreHandle_t sem );
+BaseType_t xSemaphoreGiveFromISR( SemaphoreHandle_t sem, BaseType_t *woken );
+void vSemaphoreDelete( SemaphoreHandle_t sem );
+
+#define portYIELD_FROM_ISR( woken ) ( ( void )( woken ) )
+
+#endif /* __LL_HOST_SEMPHR_H__ */
+
+//  --- EOF --- //
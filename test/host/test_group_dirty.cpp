@@ -0,0 +1,125 @@
+//
+/*
+    LiteLEDpioGroup: per-lane dirty tracking
+
+    parlio_group_flush() patches only the lanes (and byte ranges) changed since the last
+    frame into the persistent DMA buffer. Every frame on the wire must still equal a full
+    encode of all lanes (ref_group_or()). Frames change one lane, some lanes or all lanes,
+    through set_pixel, clear and per-lane brightness, with show() and with showAsync().
+    Also prints the show() time of an 8-lane sign where only the ticker lane changes, for a
+    sparse ticker (text on black) and a dense one (every byte different).
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+
+typedef struct {
+    uint32_t mask;
+    uint8_t type;
+    size_t length;
+} dirty_case_t;
+
+static const dirty_case_t cases[] = {
+    { 0x00FF, LED_STRIP_WS2812, 60 },
+    { 0x0007, LED_STRIP_WS2812, 50 },
+    { 0xFFFF, LED_STRIP_WS2812, 40 },
+    { 0x0001, LED_STRIP_WS2812, 30 },
+    { 0x00A5, LED_STRIP_SK6812, 45 },
+    { 0x0011, LED_STRIP_APA106, 35 },
+};
+
+static size_t setup_lanes( const dirty_case_t &c, host_lane_t *lanes ) {
+    size_t count = 0;
+    for ( uint8_t n = 0; n < 16; n++ ) {
+        if ( c.mask & ( 1u << n ) ) {
+            lanes[ count++ ] = { n, c.type, c.length, false };
+        }
+    }
+    return count;
+}
+
+int main() {
+    srand( 22 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    for ( const dirty_case_t &c : cases ) {
+        for ( bool async : { false, true } ) {
+            host_lane_t        lanes[ 16 ];
+            const size_t       count = setup_lanes( c, lanes );
+            parlio_group_cfg_t cfg;
+            if ( !HOST_CHECK( host_group_install( &cfg, lanes, count ) == ESP_OK ) ) {
+                continue;
+            }
+            HOST_CHECK( cfg.stream_chunk == 0 );
+            const uint8_t unit = fake_unit_index( cfg.parlio_chan );
+            int bad = 0;
+
+            for ( int frame = 0; frame < 300; frame++ ) {
+                const int mode = rand() % 4;    // 0 first lane only, 1 some lanes, 2 all lanes, 3 none
+                for ( size_t i = 0; i < count; i++ ) {
+                    led_strip_t *strip = &cfg.lanes[ lanes[ i ].lane ].strip;
+                    if ( mode == 3 || ( mode == 0 && i != 0 ) || ( mode == 1 && rand() % 3 ) ) {
+                        continue;
+                    }
+                    host_scribble( strip, rand() % 4 );
+                    if ( rand() % 40 == 0 ) {
+                        led_strip_set_brightness( strip, ( uint8_t )rand() );
+                    }
+                    if ( rand() % 60 == 0 ) {
+                        led_strip_clear( strip, host_pixel_bytes( strip ) );
+                    }
+                }
+                const size_t first = fake.tx.size();
+                HOST_CHECK( ( async ? parlio_group_flush_async( &cfg ) : parlio_group_flush( &cfg ) ) == ESP_OK );
+                bad += !ref_frame_matches( fake_wire( unit, first ), ref_group_or( &cfg ) );
+            }
+            if ( !HOST_CHECK( bad == 0 ) ) {
+                printf( "  mask 0x%04x %s: %d frames differ from a full encode\n", ( unsigned )c.mask,
+                        async ? "showAsync" : "show", bad );
+            }
+            HOST_CHECK( parlio_group_wait( &cfg, -1 ) == ESP_OK );
+            HOST_CHECK( parlio_group_free( &cfg ) == ESP_OK );
+        }
+    }
+
+    // Signage: 8 lanes of 150 LEDs, lane 0 scrolls a ticker, the other seven are static
+    host_lane_t        lanes[ 8 ];
+    parlio_group_cfg_t cfg;
+    for ( uint8_t n = 0; n < 8; n++ ) {
+        lanes[ n ] = { n, LED_STRIP_WS2812, 150, false };
+    }
+    if ( HOST_CHECK( host_group_install( &cfg, lanes, 8 ) == ESP_OK ) ) {
+        for ( uint8_t n = 0; n < 8; n++ ) {
+            host_scribble( &cfg.lanes[ n ].strip, 150 );
+        }
+        parlio_group_flush( &cfg );
+        auto ticker = [ & ]( bool dense, bool all ) {
+            if ( dense ) {
+                host_scribble( &cfg.lanes[ 0 ].strip, 150 );
+            }
+            else {
+                host_fill_sparse( &cfg.lanes[ 0 ].strip, 6 );
+            }
+            for ( uint8_t n = 1; all && n < 8; n++ ) {
+                led_strip_mark_dirty( &cfg.lanes[ n ].strip, 0, host_pixel_bytes( &cfg.lanes[ n ].strip ) );
+            }
+            parlio_group_flush( &cfg );
+        };
+        fake.keep_data = false;
+        for ( bool dense : { false, true } ) {
+            double one = host_time_us( 2000, [ & ] { ticker( dense, false ); } );
+            double all = host_time_us( 2000, [ & ] { ticker( dense, true ); } );
+            printf( "8 lanes x 150 LEDs, %s ticker lane changed: %.2f us per show(), %.2f us re-encoding all lanes\n",
+                    dense ? "dense" : "sparse", one, all );
+        }
+        fake.keep_data = true;
+        HOST_CHECK( parlio_group_free( &cfg ) == ESP_OK );
+    }
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_group_dirty" );
+}
+
+//  --- EOF --- //
@@ -0,0 +1,135 @@
+//
+/*
+    LiteLEDpioGroup: mixed lengths, RGBW and LED types
+
+    Lanes of one group may differ in length, colour size and LED type, as long as the
+    types share a PARLIO clock and samples per bit (parlio_led_fits()). Every data line of
+    every frame must carry exactly its own strip's samples (ref_lane_samples()), then stay
+    LOW until the longest lane is done; unassigned lines stay LOW throughout. The gap
+    between frames must cover the longest reset of any lane's type, and types that cannot
+    share the clock must be refused by parlio_group_install().
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+#include <algorithm>
+
+typedef struct {
+    uint32_t    mask;
+    host_lane_t lanes[ 16 ];
+    bool        streamed;
+    int         frames;
+} hetero_case_t;
+
+static const hetero_case_t cases[] = {
+    { 0x0003, { { 0, LED_STRIP_WS2812, 60, false }, { 1, LED_STRIP_SK6812, 20, true } }, false, 150 },
+    { 0x000F, { { 0, LED_STRIP_WS2812, 10, false }, { 1, LED_STRIP_SK6812, 50, true },
+                { 2, LED_STRIP_SM16703, 33, false }, { 3, LED_STRIP_WS2812_RGB, 1, false } }, false, 150 },
+    { 0x0081, { { 0, LED_STRIP_SK6812, 7, true }, { 7, LED_STRIP_WS2812, 40, false } }, false, 150 },
+    { 0x8001, { { 0, LED_STRIP_WS2812, 100, false }, { 15, LED_STRIP_SM16703, 3, false } }, false, 150 },
+    { 0x0001, { { 0, LED_STRIP_SK6812, 12, true } }, false, 150 },
+    { 0x0003, { { 0, LED_STRIP_APA106, 20, false }, { 1, LED_STRIP_APA106, 35, true } }, false, 150 },
+    // streamed: the longest lane needs more than the whole-frame buffer limit
+    { 0x00FF, { { 0, LED_STRIP_WS2812, 4000, false }, { 1, LED_STRIP_WS2812, 10, false },
+                { 2, LED_STRIP_SK6812, 2000, true }, { 3, LED_STRIP_WS2812, 5, false },
+                { 4, LED_STRIP_SM16703, 3000, false }, { 5, LED_STRIP_WS2812, 1, false },
+                { 6, LED_STRIP_WS2812, 4000, true }, { 7, LED_STRIP_WS2812_RGB, 50, false } }, true, 12 },
+};
+
+static size_t lane_count( const hetero_case_t &c ) {
+    return ( size_t )__builtin_popcount( c.mask );
+}
+
+// 1 if any data line of the frame differs from its strip's samples, else 0
+static int check_frame( const parlio_group_cfg_t *cfg, const std::vector<uint8_t> &wire ) {
+    size_t frame_bytes = 0;
+    int    spb         = 0;
+    for ( uint8_t n = 0; n < PARLIO_TX_UNIT_MAX_DATA_WIDTH; n++ ) {
+        if ( cfg->lanes[ n ].assigned ) {
+            frame_bytes = std::max( frame_bytes, host_pixel_bytes( &cfg->lanes[ n ].strip ) );
+            spb         = parlio_led_params[ cfg->lanes[ n ].strip.type ].samples_per_bit;
+        }
+    }
+    for ( uint8_t n = 0; n < cfg->data_width; n++ ) {
+        std::vector<uint8_t> got = ref_wire_samples( wire, cfg->data_width, n );
+        std::vector<uint8_t> ref;
+        if ( cfg->lanes[ n ].assigned ) {
+            ref = ref_lane_samples( &cfg->lanes[ n ].strip, frame_bytes );
+        }
+        else {
+            ref.assign( frame_bytes * 8 * spb, 0 );
+        }
+        if ( got.size() < ref.size() || !std::equal( ref.begin(), ref.end(), got.begin() ) ||
+             std::any_of( got.begin() + ref.size(), got.end(), []( uint8_t s ) { return s != 0; } ) ) {
+            printf( "  line %u differs from its strip\n", n );
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main() {
+    srand( 23 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    for ( const hetero_case_t &c : cases ) {
+        for ( bool async : { false, true } ) {
+            const size_t       count = lane_count( c );
+            parlio_group_cfg_t cfg;
+            if ( !HOST_CHECK( host_group_install( &cfg, c.lanes, count ) == ESP_OK ) ) {
+                continue;
+            }
+            const uint8_t unit     = fake_unit_index( cfg.parlio_chan );
+            uint16_t      reset_us = 0;
+            for ( size_t i = 0; i < count; i++ ) {
+                reset_us = std::max( reset_us, parlio_led_params[ c.lanes[ i ].type ].reset_us );
+            }
+            int bad = 0;
+            int gap = 0;
+
+            for ( int frame = 0; frame < c.frames; frame++ ) {
+                const int mode = rand() % 4;    // 0 first lane only, 1 some lanes, 2 all lanes, 3 none
+                for ( size_t i = 0; i < count; i++ ) {
+                    led_strip_t *strip = &cfg.lanes[ c.lanes[ i ].lane ].strip;
+                    if ( mode == 3 || ( mode == 0 && i != 0 ) || ( mode == 1 && rand() % 3 ) ) {
+                        continue;
+                    }
+                    host_scribble( strip, rand() % 4 );
+                    if ( rand() % 40 == 0 ) {
+                        led_strip_set_brightness( strip, ( uint8_t )rand() );
+                    }
+                    if ( rand() % 60 == 0 ) {
+                        led_strip_clear( strip, host_pixel_bytes( strip ) );
+                    }
+                }
+                const size_t first = fake.tx.size();
+                HOST_CHECK( ( async ? parlio_group_flush_async( &cfg ) : parlio_group_flush( &cfg ) ) == ESP_OK );
+                bad += check_frame( &cfg, fake_wire( unit, first ) );
+                if ( frame > 0 && fake.tx[ first ].start_us - fake.tx[ first - 1 ].end_us < reset_us ) {
+                    gap++;
+                }
+            }
+            if ( !HOST_CHECK( bad == 0 && gap == 0 ) ) {
+                printf( "  mask 0x%04x %s: %d frames differ, %d frames latched early\n", ( unsigned )c.mask,
+                        async ? "showAsync" : "show", bad, gap );
+            }
+            HOST_CHECK( ( cfg.stream_chunk != 0 ) == c.streamed );
+            HOST_CHECK( parlio_group_wait( &cfg, -1 ) == ESP_OK );
+            HOST_CHECK( parlio_group_free( &cfg ) == ESP_OK );
+        }
+    }
+
+    // Types on different clocks cannot share a TX unit
+    HOST_CHECK( !parlio_led_fits( LED_STRIP_WS2812, LED_STRIP_APA106 ) );
+    const host_lane_t mixed[] = { { 0, LED_STRIP_WS2812, 10, false }, { 1, LED_STRIP_APA106, 10, false } };
+    parlio_group_cfg_t cfg;
+    HOST_CHECK( host_group_install( &cfg, mixed, 2 ) == ESP_ERR_NOT_SUPPORTED );
+    HOST_CHECK( cfg.parlio_chan == NULL && cfg.parlio_buf == NULL );
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_group_hetero" );
+}
+
+//  --- EOF --- //
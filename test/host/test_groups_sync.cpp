@@ -0,0 +1,154 @@
+//
+/*
+    LiteLEDpioGroup::showAll(): synchronized flush of several groups
+
+    Built for a chip with four PARLIO TX units. parlio_groups_flush() /
+    parlio_groups_flush_async() encode every group first and only then queue their
+    transfers, back to back. Each group's wire must equal a full encode of its lanes
+    (ref_group_or()) and, with no CPU time modelled, all transfers of a frame must be
+    queued at the same instant. Lists with a group twice, too many groups, or a streamed
+    group are refused before anything is sent. On a modelled CPU the start skew between
+    the groups must stay well below that of flushing them one by one; both are printed.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+#include <algorithm>
+
+static_assert( LL_PARLIO_TX_UNITS == 4, "build with SOC_PARLIO_TX_UNITS_PER_GROUP=4" );
+
+typedef struct {
+    uint32_t mask;
+    uint8_t  type;
+    size_t   length;
+} sync_group_t;
+
+static const sync_group_t groups[] = {
+    { 0x00FF, LED_STRIP_WS2812, 30 },
+    { 0x0007, LED_STRIP_SK6812, 50 },
+    { 0x0001, LED_STRIP_WS2812, 20 },
+};
+static const uint8_t GROUPS = sizeof( groups ) / sizeof( groups[ 0 ] );
+
+static esp_err_t install( parlio_group_cfg_t *cfg, uint32_t mask, uint8_t type, size_t length ) {
+    host_lane_t lanes[ 16 ];
+    size_t      count = 0;
+    for ( uint8_t n = 0; n < 16; n++ ) {
+        if ( mask & ( 1u << n ) ) {
+            lanes[ count ] = { n, type, length + n, false };    // lanes of uneven length
+            count++;
+        }
+    }
+    return host_group_install( cfg, lanes, count );
+}
+
+// Largest difference between the start times of the transfers from index first on
+static int64_t start_skew( size_t first ) {
+    int64_t lo = INT64_MAX, hi = INT64_MIN;
+    for ( size_t i = first; i < fake.tx.size(); i++ ) {
+        lo = std::min( lo, fake.tx[ i ].start_us );
+        hi = std::max( hi, fake.tx[ i ].start_us );
+    }
+    return hi - lo;
+}
+
+int main() {
+    srand( 25 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    parlio_group_cfg_t  cfg[ GROUPS ];
+    parlio_group_cfg_t *list[ GROUPS ];
+    for ( uint8_t k = 0; k < GROUPS; k++ ) {
+        HOST_CHECK( install( &cfg[ k ], groups[ k ].mask, groups[ k ].type, groups[ k ].length ) == ESP_OK );
+        list[ k ] = &cfg[ k ];
+    }
+
+    for ( bool async : { false, true } ) {
+        int bad    = 0;
+        int spread = 0;
+        for ( int frame = 0; frame < 200; frame++ ) {
+            for ( uint8_t k = 0; k < GROUPS; k++ ) {
+                for ( uint8_t n = 0; n < 16; n++ ) {
+                    if ( cfg[ k ].lanes[ n ].assigned && rand() % 3 == 0 ) {
+                        host_scribble( &cfg[ k ].lanes[ n ].strip, 1 + rand() % 4 );
+                    }
+                }
+            }
+            const size_t first = fake.tx.size();
+            HOST_CHECK( ( async ? parlio_groups_flush_async( list, GROUPS ) : parlio_groups_flush( list, GROUPS ) ) == ESP_OK );
+            if ( !HOST_CHECK( fake.tx.size() == first + GROUPS ) ) {
+                continue;
+            }
+            for ( uint8_t k = 0; k < GROUPS; k++ ) {
+                bad += !ref_frame_matches( fake_wire( fake_unit_index( cfg[ k ].parlio_chan ), first ), ref_group_or( &cfg[ k ] ) );
+                spread += fake.tx[ first + k ].queued_us != fake.tx[ first ].queued_us;
+            }
+        }
+        if ( !HOST_CHECK( bad == 0 && spread == 0 ) ) {
+            printf( "  %s: %d group frames differ from a full encode, %d queued late\n",
+                    async ? "showAllAsync" : "showAll", bad, spread );
+        }
+        for ( uint8_t k = 0; k < GROUPS; k++ ) {
+            HOST_CHECK( parlio_group_wait( &cfg[ k ], -1 ) == ESP_OK );
+        }
+    }
+
+    // Refused lists: nothing may be sent
+    parlio_group_cfg_t  streamed;
+    parlio_group_cfg_t *twice[]    = { &cfg[ 0 ], &cfg[ 1 ], &cfg[ 0 ] };
+    parlio_group_cfg_t *too_many[] = { &cfg[ 0 ], &cfg[ 1 ], &cfg[ 2 ], &streamed, &cfg[ 0 ] };
+    parlio_group_cfg_t *with_str[] = { &cfg[ 0 ], &streamed };
+    HOST_CHECK( install( &streamed, 0x00FF, LED_STRIP_WS2812, 4000 ) == ESP_OK );
+    HOST_CHECK( streamed.stream_chunk != 0 );
+    const size_t sent = fake.tx.size();
+    HOST_CHECK( parlio_groups_flush( twice, 3 ) == ESP_ERR_INVALID_ARG );
+    HOST_CHECK( parlio_groups_flush( too_many, 5 ) == ESP_ERR_INVALID_ARG );
+    HOST_CHECK( parlio_groups_flush_async( with_str, 2 ) == ESP_ERR_NOT_SUPPORTED );
+    HOST_CHECK( parlio_groups_flush( with_str, 2 ) == ESP_ERR_NOT_SUPPORTED );
+    HOST_CHECK( fake.tx.size() == sent );
+    HOST_CHECK( parlio_group_free( &streamed ) == ESP_OK );
+
+    // Start skew with CPU time modelled: all groups at once vs one group after another
+    fake.cpu_scale = 20;
+    fake.keep_data = false;
+    std::vector<int64_t> together, apart;
+    for ( int frame = 0; frame < 51; frame++ ) {
+        for ( uint8_t k = 0; k < GROUPS; k++ ) {
+            host_scribble( &cfg[ k ].lanes[ 0 ].strip, 8 );
+        }
+        size_t first = fake.tx.size();
+        parlio_groups_flush( list, GROUPS );
+        together.push_back( start_skew( first ) );
+
+        for ( uint8_t k = 0; k < GROUPS; k++ ) {
+            host_scribble( &cfg[ k ].lanes[ 0 ].strip, 8 );
+        }
+        first = fake.tx.size();
+        for ( uint8_t k = 0; k < GROUPS; k++ ) {
+            parlio_group_flush_async( &cfg[ k ] );
+        }
+        for ( uint8_t k = 0; k < GROUPS; k++ ) {
+            parlio_group_wait( &cfg[ k ], -1 );
+        }
+        apart.push_back( start_skew( first ) );
+    }
+    fake.cpu_scale = 0;
+    fake.keep_data = true;
+    std::sort( together.begin(), together.end() );
+    std::sort( apart.begin(), apart.end() );
+    // Encoding between the transfers would put showAll() on a par with one group at a time
+    HOST_CHECK( together[ 25 ] * 10 < apart[ 25 ] );
+    printf( "%u groups, start skew (median / worst): %lld / %lld us with showAll(), %lld / %lld us with showAsync() per group\n",
+            GROUPS, ( long long )together[ 25 ], ( long long )together.back(),
+            ( long long )apart[ 25 ], ( long long )apart.back() );
+
+    for ( uint8_t k = 0; k < GROUPS; k++ ) {
+        HOST_CHECK( parlio_group_free( &cfg[ k ] ) == ESP_OK );
+    }
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_groups_sync" );
+}
+
+//  --- EOF --- //
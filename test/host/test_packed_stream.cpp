@@ -0,0 +1,138 @@
+//
+/*
+    LiteLEDpio: packed single-strip mode (data_width 1)
+
+    A strip sent packed, eight samples per DMA byte, must put exactly the same samples on
+    its pin as the byte-per-sample stream (data_width 8) of the same pixels: every LED type,
+    RGB and RGBW, several lengths and brightness levels, whole frames and streamed ones.
+    The fake reads the packed bytes back in the unit's bit_pack_order, so a packing order
+    that does not match the encoder shows up as wrong samples. The packed buffer must be
+    an eighth of the byte-per-sample one; the sizes of a 1000-LED strip are printed.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+
+typedef struct {
+    uint8_t type;
+    size_t  length;
+    bool    rgbw;
+} packed_case_t;
+
+static const packed_case_t cases[] = {
+    { LED_STRIP_WS2812, 1, false },
+    { LED_STRIP_WS2812, 150, false },
+    { LED_STRIP_WS2812_RGB, 77, false },
+    { LED_STRIP_SK6812, 60, true },
+    { LED_STRIP_APA106, 45, false },
+    { LED_STRIP_SM16703, 200, false },
+    { LED_STRIP_WS2812, 1500, false },      // streamed at data_width 8, whole frame packed
+    { LED_STRIP_SK6812, 4000, true },       // streamed either way
+};
+
+typedef struct {
+    std::vector<uint8_t> samples;   /* the data line, one entry per sample */
+    size_t               buf_bytes; /* DMA bytes of one frame */
+    bool                 streamed;
+} packed_run_t;
+
+// Send the same frames (seeded pixels, each brightness) at one data width
+static std::vector<packed_run_t> send( const packed_case_t &c, uint8_t width, unsigned seed ) {
+    std::vector<packed_run_t> runs;
+    led_strip_t               strip;
+    parlio_strip_cfg_t        cfg = parlio_strip_cfg_t();
+    host_strip_setup( &strip, c.type, c.length, c.rgbw );
+    parlio_strip_init( &strip, &cfg );
+    cfg.data_width = width;
+    if ( !HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+        return runs;
+    }
+    const uint8_t unit = fake_unit_index( cfg.parlio_chan );
+    srand( seed );
+    for ( uint8_t brightness : { 255, 90, 1 } ) {
+        host_scribble( &strip, c.length / 3 + 1 );
+        led_strip_set_brightness( &strip, brightness );
+        const size_t first = fake.tx.size();
+        HOST_CHECK( parlio_strip_flush( &strip, &cfg ) == ESP_OK );
+        packed_run_t run;
+        run.samples   = ref_wire_samples( fake_wire( unit, first ), width, 0 );
+        run.buf_bytes = cfg.stream_chunk ? 0 : cfg.parlio_buf_bytes;
+        run.streamed  = cfg.stream_chunk != 0;
+        runs.push_back( run );
+    }
+    HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+    return runs;
+}
+
+// The samples of a line up to sample_count, then nothing but LOW padding
+static bool same_line( const std::vector<uint8_t> &a, const std::vector<uint8_t> &b, size_t sample_count ) {
+    if ( a.size() < sample_count || b.size() < sample_count ) {
+        return false;
+    }
+    for ( size_t t = 0; t < sample_count; t++ ) {
+        if ( a[ t ] != b[ t ] ) {
+            return false;
+        }
+    }
+    for ( size_t t = sample_count; t < a.size(); t++ ) {
+        if ( a[ t ] ) {
+            return false;
+        }
+    }
+    for ( size_t t = sample_count; t < b.size(); t++ ) {
+        if ( b[ t ] ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    unsigned seed = 12;
+    for ( const packed_case_t &c : cases ) {
+        const std::vector<packed_run_t> bytes  = send( c, 8, seed );
+        const std::vector<packed_run_t> packed = send( c, 1, seed );
+        seed++;
+        if ( !HOST_CHECK( bytes.size() == 3 && packed.size() == 3 ) ) {
+            continue;
+        }
+        led_strip_t strip;
+        host_strip_setup( &strip, c.type, c.length, c.rgbw );
+        const size_t sample_count = host_pixel_bytes( &strip ) * 8 * parlio_led_params[ c.type ].samples_per_bit;
+        for ( size_t f = 0; f < 3; f++ ) {
+            if ( !HOST_CHECK( same_line( bytes[ f ].samples, packed[ f ].samples, sample_count ) ) ) {
+                printf( "  type %u, %u LEDs%s, frame %u: packed samples differ from data_width 8\n", c.type,
+                        ( unsigned )c.length, c.rgbw ? " RGBW" : "", ( unsigned )f );
+            }
+        }
+        if ( !bytes[ 0 ].streamed && !packed[ 0 ].streamed ) {
+            // Both word aligned: the packed frame is an eighth, give or take the padding
+            HOST_CHECK( packed[ 0 ].buf_bytes <= bytes[ 0 ].buf_bytes / 8 + 4 );
+        }
+    }
+
+    // DMA buffer of a 1000-LED RGB strip
+    size_t bufs[ 2 ];
+    for ( int i = 0; i < 2; i++ ) {
+        led_strip_t        strip;
+        parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+        host_strip_setup( &strip, LED_STRIP_WS2812, 1000 );
+        parlio_strip_init( &strip, &cfg );
+        cfg.data_width = i ? 1 : 8;
+        HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK );
+        bufs[ i ] = cfg.stream_chunk ? 2 * cfg.stream_chunk : cfg.parlio_buf_bytes;
+        printf( "1000 LEDs, data_width %u: %u DMA bytes%s\n", cfg.data_width, ( unsigned )bufs[ i ],
+                cfg.stream_chunk ? " (two streaming chunks)" : "" );
+        HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+    }
+    HOST_CHECK( bufs[ 1 ] == 1000 * 3 * 3 );
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_packed_stream" );
+}
+
+//  --- EOF --- //
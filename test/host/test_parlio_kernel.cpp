@@ -0,0 +1,118 @@
+//
+/*
+    LiteLEDpio: table-driven byte expansion
+
+    parlio_strip_flush() expands each LED byte through the nibble table (nib_lut, word stores
+    at data_width 8) or the packed table (pack_lut, data_width 1). Strips whose bytes run
+    through all 256 values must come out as the reference bit loop's samples for every LED
+    type, colour size and brightness, whole and streamed. Also prints the expansion rate of
+    the table kernel against the bit loop it replaced, with the stores each makes per LED
+    byte, which carry over to the C6 where the host times do not.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+
+// The expansion parlio_strip_flush() used before the nibble table: one DMA byte per sample
+static void bit_loop_encode( uint8_t b, const parlio_led_params_t *p, uint8_t *out ) {
+    for ( int i = 7; i >= 0; i-- ) {
+        uint8_t pat = ( ( b >> i ) & 1 ) ? p->bit1_pattern : p->bit0_pattern;
+        for ( int s = p->samples_per_bit - 1; s >= 0; s-- ) {
+            *out++ = ( pat >> s ) & 1;
+        }
+    }
+}
+
+// Every byte value in turn, offset so consecutive frames differ
+static void fill_all_values( led_strip_t *strip, uint8_t offset ) {
+    for ( size_t b = 0; b < host_pixel_bytes( strip ); b++ ) {
+        strip->buf[ b ] = ( uint8_t )( b * 7 + offset );
+    }
+    led_strip_mark_dirty( strip, 0, host_pixel_bytes( strip ) );
+}
+
+typedef struct {
+    uint8_t type;
+    size_t  length;
+    bool    rgbw;
+} kernel_case_t;
+
+static const kernel_case_t cases[] = {
+    { LED_STRIP_WS2812, 100, false },
+    { LED_STRIP_WS2812_RGB, 86, false },
+    { LED_STRIP_SK6812, 64, true },
+    { LED_STRIP_APA106, 90, false },        // 4 samples per bit
+    { LED_STRIP_SM16703, 33, false },
+    { LED_STRIP_WS2812, 1000, false },      // streamed at data_width 8
+};
+
+int main() {
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    for ( const kernel_case_t &c : cases ) {
+        for ( uint8_t width : { 8, 1 } ) {
+            led_strip_t        strip;
+            parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+            host_strip_setup( &strip, c.type, c.length, c.rgbw );
+            HOST_CHECK( parlio_strip_init( &strip, &cfg ) == ESP_OK );
+            cfg.data_width = width;
+            if ( !HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+                continue;
+            }
+            HOST_CHECK( ( ( uintptr_t )cfg.parlio_buf & 3 ) == 0 );
+            const uint8_t unit = fake_unit_index( cfg.parlio_chan );
+            int bad = 0;
+            for ( uint8_t brightness : { 255, 128, 3 } ) {
+                led_strip_set_brightness( &strip, brightness );
+                fill_all_values( &strip, brightness );
+                const size_t first = fake.tx.size();
+                HOST_CHECK( parlio_strip_flush( &strip, &cfg ) == ESP_OK );
+                const std::vector<uint8_t> ref = ( width == 1 ) ? ref_strip_packed( &strip ) : ref_strip_bytes( &strip );
+                bad += !ref_frame_matches( fake_wire( unit, first ), ref );
+            }
+            if ( !HOST_CHECK( bad == 0 ) ) {
+                printf( "  type %u, %u LEDs, data_width %u%s: %d frames differ from the bit loop\n", c.type,
+                        ( unsigned )c.length, width, cfg.stream_chunk ? " (streamed)" : "", bad );
+            }
+            HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+        }
+    }
+
+    // Rate: 400 WS2812 LEDs (whole frame at data_width 8), every byte different from the last
+    led_strip_t        strip;
+    parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+    host_strip_setup( &strip, LED_STRIP_WS2812, 400 );
+    parlio_strip_init( &strip, &cfg );
+    if ( HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+        const parlio_led_params_t *p     = &parlio_led_params[ LED_STRIP_WS2812 ];
+        const size_t               bytes = host_pixel_bytes( &strip );
+        const size_t               block = 8 * p->samples_per_bit;
+        std::vector<uint8_t>       out( bytes * block );
+        fill_all_values( &strip, 0 );
+
+        fake.keep_data = false;
+        double table = host_time_us( 2000, [ & ] {
+            led_strip_mark_dirty( &strip, 0, bytes );
+            parlio_strip_flush( &strip, &cfg );
+        } );
+        double loop = host_time_us( 2000, [ & ] {
+            for ( size_t b = 0; b < bytes; b++ ) {
+                bit_loop_encode( strip.bright_lut[ strip.buf[ b ] ], p, &out[ b * block ] );
+            }
+        } );
+        fake.keep_data = true;
+        // Host times say little about the C6's in-order core; the store counts carry over
+        printf( "400 LEDs, %u DMA bytes: nibble table %.2f us (%.0f MB/s, flush included, %u word stores per LED byte), "
+                "bit loop %.2f us (%.0f MB/s, %u byte stores)\n",
+                ( unsigned )out.size(), table, out.size() / table, ( unsigned )( block / 4 ),
+                loop, out.size() / loop, ( unsigned )block );
+        HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+    }
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_parlio_kernel" );
+}
+
+//  --- EOF --- //
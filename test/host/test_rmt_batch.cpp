@@ -0,0 +1,90 @@
+//
+/*
+    LiteLED RMT: batch encoder callback
+
+    led_encoder_batch_cb() must produce the same symbol stream as led_encoder_cb() and the
+    reference (ref_rmt_symbols()) for every LED type, colour size, brightness and RMT memory
+    size, including frames whose last byte fills the memory exactly so the reset goes out on
+    the next call, and it must leave enc_pos at 0 for the next frame. Also prints callbacks
+    per frame and symbols per microsecond of both callbacks for a 1000-LED strip.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_encoder.h"
+
+typedef struct {
+    uint8_t type;
+    size_t  length;
+    bool    rgbw;
+} rmt_case_t;
+
+static const rmt_case_t cases[] = {
+    { LED_STRIP_WS2812, 1, false },
+    { LED_STRIP_WS2812, 8, false },         // 24 bytes: 192 symbols, whole refills of 48 / 96
+    { LED_STRIP_WS2812, 300, false },
+    { LED_STRIP_SK6812, 32, true },         // 128 bytes: exactly one 1024-symbol DMA buffer
+    { LED_STRIP_SK6812, 77, true },
+    { LED_STRIP_APA106, 50, false },
+    { LED_STRIP_SM16703, 13, false },
+};
+
+static const size_t mem_sizes[] = { 48, 96, 1024 };     // one block, two blocks, DMA
+
+int main() {
+    srand( 1 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    for ( const rmt_case_t &c : cases ) {
+        led_strip_t strip;
+        host_rmt_setup( &strip, c.type, c.length, c.rgbw );
+        if ( !HOST_CHECK( strip.buf && strip.stripCfg.sym_lut ) ) {
+            continue;
+        }
+        for ( uint8_t brightness : { 255, 100, 1 } ) {
+            led_strip_set_brightness( &strip, brightness );
+            for ( size_t mem : mem_sizes ) {
+                for ( int frame = 0; frame < 3; frame++ ) {
+                    host_scribble( &strip, c.length / 2 + 1 );
+                    if ( frame == 2 ) {
+                        host_fill_sparse( &strip, 5 );
+                    }
+                    const std::vector<uint32_t> ref = ref_rmt_symbols( &strip );
+                    std::vector<uint32_t>       byte, batch;
+                    host_rmt_frame( led_encoder_cb, &strip, mem, &byte );
+                    HOST_CHECK( strip.stripCfg.enc_pos == 0 );
+                    host_rmt_frame( led_encoder_batch_cb, &strip, mem, &batch );
+                    HOST_CHECK( strip.stripCfg.enc_pos == 0 );
+                    if ( !HOST_CHECK( byte == ref && batch == ref ) ) {
+                        printf( "  type %u, %u LEDs, brightness %u, %u symbols: byte %s, batch %s\n", c.type,
+                                ( unsigned )c.length, brightness, ( unsigned )mem,
+                                byte == ref ? "ok" : "differs", batch == ref ? "ok" : "differs" );
+                    }
+                }
+            }
+        }
+        host_rmt_free( &strip );
+    }
+
+    // 1000 WS2812 LEDs, every pixel lit
+    led_strip_t strip;
+    host_rmt_setup( &strip, LED_STRIP_WS2812, 1000 );
+    host_scribble( &strip, 4000 );
+    const size_t symbols = host_pixel_bytes( &strip ) * 8 + 1;
+    for ( size_t mem : { ( size_t )48, ( size_t )1024 } ) {
+        size_t calls_byte  = host_rmt_frame( led_encoder_cb, &strip, mem, NULL );
+        size_t calls_batch = host_rmt_frame( led_encoder_batch_cb, &strip, mem, NULL );
+        double us_byte     = host_time_us( 500, [ & ] { host_rmt_frame( led_encoder_cb, &strip, mem, NULL ); } );
+        double us_batch    = host_time_us( 500, [ & ] { host_rmt_frame( led_encoder_batch_cb, &strip, mem, NULL ); } );
+        HOST_CHECK( calls_batch * 3 < calls_byte );
+        printf( "1000 LEDs, %4u-symbol memory: byte %5u callbacks, %6.1f symbols/us; batch %4u callbacks, %6.1f symbols/us\n",
+                ( unsigned )mem, ( unsigned )calls_byte, symbols / us_byte, ( unsigned )calls_batch, symbols / us_batch );
+    }
+    host_rmt_free( &strip );
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_rmt_batch" );
+}
+
+//  --- EOF --- //
@@ -0,0 +1,140 @@
+//
+/*
+    LiteLED: run-length fast paths on sparse and dense frames
+
+    The encoders with a run path (ll_frame_encode()'s doubled runs, the PARLIO strip's and
+    group's replicated blocks) and the batch RMT callback, which has none, must give the
+    reference output for a sparse chaser frame (mostly black), a white fill (one run of a
+    constant byte) and a dense frame (every pixel random). Also prints the time of a full
+    encode of each frame kind per encoder, to see what the run paths gain on sparse and
+    white frames and cost on dense ones.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_encoder.h"
+#include "ll_parlio_core.h"
+
+enum { FRAME_SPARSE, FRAME_WHITE, FRAME_DENSE, FRAME_KINDS };
+static const char *kind_name[ FRAME_KINDS ] = { "sparse", "white", "dense" };
+
+static void paint( led_strip_t *strip, int kind ) {
+    switch ( kind ) {
+        case FRAME_SPARSE:
+            host_fill_sparse( strip, 20 );
+            break;
+        case FRAME_WHITE: {
+            const uint8_t level = ( uint8_t )( 1 + rand() % 255 );
+            led_strip_fill( strip, rgb_from_code( level * 0x010101u ) );
+            break;
+        }
+        default:
+            host_scribble( strip, strip->length * 4 );
+            break;
+    }
+}
+
+static std::vector<uint32_t> frame_symbols( const led_strip_t *strip, size_t count ) {
+    std::vector<uint32_t> symbols;
+    for ( size_t i = 0; i < count; i++ ) {
+        symbols.push_back( strip->stripCfg.frame_buf[ i ].val );
+    }
+    return symbols;
+}
+
+int main() {
+    srand( 7 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    double us[ 4 ][ FRAME_KINDS ];
+
+    // RMT: 300 WS2812 LEDs through the batch callback (DMA memory) and ll_frame_encode()
+    led_strip_t rmt;
+    host_rmt_setup( &rmt, LED_STRIP_WS2812, 300 );
+    rmt.stripCfg.frame_buf = ( rmt_symbol_word_t * )heap_caps_malloc( ( host_pixel_bytes( &rmt ) * 8 + 1 ) *
+                             sizeof( rmt_symbol_word_t ), MALLOC_CAP_INTERNAL );
+    for ( int kind = 0; kind < FRAME_KINDS; kind++ ) {
+        for ( uint8_t brightness : { 60, 255 } ) {
+            paint( &rmt, kind );
+            led_strip_set_brightness( &rmt, brightness );
+            const std::vector<uint32_t> ref = ref_rmt_symbols( &rmt );
+            std::vector<uint32_t>       batch;
+            host_rmt_frame( led_encoder_batch_cb, &rmt, 1024, &batch );
+            size_t count = ll_frame_encode( &rmt, rmt.buf, host_pixel_bytes( &rmt ) );
+            HOST_CHECK( batch == ref );
+            HOST_CHECK( frame_symbols( &rmt, count ) == ref );
+        }
+        us[ 0 ][ kind ] = host_time_us( 1000, [ & ] { host_rmt_frame( led_encoder_batch_cb, &rmt, 1024, NULL ); } );
+        us[ 1 ][ kind ] = host_time_us( 1000, [ & ] { ll_frame_encode( &rmt, rmt.buf, host_pixel_bytes( &rmt ) ); } );
+    }
+    heap_caps_free( rmt.stripCfg.frame_buf );
+    host_rmt_free( &rmt );
+
+    // PARLIO: a 300-LED strip at data_width 8
+    led_strip_t        pio;
+    parlio_strip_cfg_t pio_cfg = parlio_strip_cfg_t();
+    host_strip_setup( &pio, LED_STRIP_WS2812, 300 );
+    HOST_CHECK( parlio_strip_init( &pio, &pio_cfg ) == ESP_OK );
+    if ( HOST_CHECK( parlio_strip_install( &pio, &pio_cfg ) == ESP_OK ) ) {
+        const uint8_t unit = fake_unit_index( pio_cfg.parlio_chan );
+        HOST_CHECK( pio_cfg.stream_chunk == 0 );
+        for ( int kind = 0; kind < FRAME_KINDS; kind++ ) {
+            for ( uint8_t brightness : { 60, 255 } ) {
+                paint( &pio, kind );
+                led_strip_set_brightness( &pio, brightness );
+                const size_t first = fake.tx.size();
+                HOST_CHECK( parlio_strip_flush( &pio, &pio_cfg ) == ESP_OK );
+                HOST_CHECK( ref_frame_matches( fake_wire( unit, first ), ref_strip_bytes( &pio ) ) );
+            }
+            fake.keep_data = false;
+            us[ 2 ][ kind ] = host_time_us( 1000, [ & ] {
+                led_strip_mark_dirty( &pio, 0, host_pixel_bytes( &pio ) );
+                parlio_strip_flush( &pio, &pio_cfg );
+            } );
+            fake.keep_data = true;
+        }
+        HOST_CHECK( parlio_strip_free( &pio, &pio_cfg ) == ESP_OK );
+    }
+
+    // PARLIO: an 8 x 150 LED group, lane 3 at its own brightness
+    host_lane_t        lanes[ 8 ];
+    parlio_group_cfg_t group;
+    for ( uint8_t n = 0; n < 8; n++ ) {
+        lanes[ n ] = { n, LED_STRIP_WS2812, 150, false };
+    }
+    if ( HOST_CHECK( host_group_install( &group, lanes, 8 ) == ESP_OK ) ) {
+        const uint8_t unit = fake_unit_index( group.parlio_chan );
+        for ( int kind = 0; kind < FRAME_KINDS; kind++ ) {
+            for ( uint8_t brightness : { 60, 255 } ) {
+                for ( uint8_t n = 0; n < 8; n++ ) {
+                    paint( &group.lanes[ n ].strip, kind );
+                }
+                led_strip_set_brightness( &group.lanes[ 3 ].strip, brightness );
+                const size_t first = fake.tx.size();
+                HOST_CHECK( parlio_group_flush( &group ) == ESP_OK );
+                HOST_CHECK( ref_frame_matches( fake_wire( unit, first ), ref_group_or( &group ) ) );
+            }
+            fake.keep_data = false;
+            us[ 3 ][ kind ] = host_time_us( 1000, [ & ] {
+                for ( uint8_t n = 0; n < 8; n++ ) {
+                    led_strip_mark_dirty( &group.lanes[ n ].strip, 0, host_pixel_bytes( &group.lanes[ n ].strip ) );
+                }
+                parlio_group_flush( &group );
+            } );
+            fake.keep_data = true;
+        }
+        HOST_CHECK( parlio_group_free( &group ) == ESP_OK );
+    }
+
+    static const char *encoder_name[ 4 ] = { "RMT batch callback", "RMT frame encode", "PARLIO strip", "PARLIO group 8 x 150" };
+    printf( "300 LEDs, full encode, us per frame %8s %8s %8s\n", kind_name[ 0 ], kind_name[ 1 ], kind_name[ 2 ] );
+    for ( int e = 0; e < 4; e++ ) {
+        printf( "  %-33s %8.2f %8.2f %8.2f\n", encoder_name[ e ], us[ e ][ 0 ], us[ e ][ 1 ], us[ e ][ 2 ] );
+    }
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_sparse_dense" );
+}
+
+//  --- EOF --- //
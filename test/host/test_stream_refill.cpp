@@ -0,0 +1,211 @@
+//
+/*
+    LiteLEDpio: streaming refill timing
+
+    Frames above LL_PARLIO_STREAM_THRESHOLD go out through two ping-pong chunks: while one
+    is on the wire the other is encoded and queued behind it. Each chunk's margin is the
+    time between its transmit call and the end of the chunk ahead of it; below zero the
+    wire ran dry mid-frame (an underrun, which the LEDs take as a latch).
+
+    Even a chunk queued in time starts only once the driver has set up its transaction
+    after the chunk ahead ends (fake.restart_us, RESTART_US here), and the line idles LOW
+    meanwhile, in the middle of LED data. That hole must stay well below the shortest
+    reset_us of any LED type, or the strip latches early.
+
+    With no CPU time modelled every chunk must be queued by the time the chunk ahead of it
+    starts, a full chunk of wire time early, and every hole must be the restart gap. With the host CPU time scaled by 20 (fake.cpu_scale)
+    the refill time, minimum margin, chunk wire time and the CPU slowdown at which the
+    refill would stop keeping up are printed for strips (data_width 8 and 1, up to 10000
+    LEDs) and groups, along with the widest hole. A CPU slowed far past that must show as
+    underruns, holes wider than the restart gap. At every scale
+    the frame must match the reference and no chunk may be written while on the wire.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+#include <algorithm>
+
+// Time the driver is assumed to take to start a queued transaction after the one ahead of
+// it ends: the TX done ISR of the C6 driver sets up the next DMA descriptor chain. An estimate
+static const int64_t RESTART_US = 3;
+
+typedef struct {
+    size_t  chunks;
+    size_t  underruns;          /* chunks queued after the one ahead of them ended */
+    int64_t wire_us;            /* wire time of the first (full) chunk */
+    int64_t min_margin;
+    int64_t median_margin;
+    int64_t max_hole;           /* widest LOW gap between two chunks */
+    bool    ahead;              /* every chunk queued by the time the chunk ahead of it started */
+} refill_t;
+
+// Refill margins of the transfers of one frame, from index first on
+static refill_t refill_margins( size_t first ) {
+    refill_t             r = {};
+    std::vector<int64_t> margins;
+    r.chunks  = fake.tx.size() - first;
+    r.wire_us = r.chunks ? fake.tx[ first ].end_us - fake.tx[ first ].start_us : 0;
+    r.ahead   = true;
+    for ( size_t i = first + 1; i < fake.tx.size(); i++ ) {
+        const fake_tx_t &ahead = fake.tx[ i - 1 ];
+        const fake_tx_t &tx    = fake.tx[ i ];
+        margins.push_back( ahead.end_us - tx.queued_us );
+        r.underruns += margins.back() < 0;
+        r.max_hole   = std::max( r.max_hole, tx.start_us - ahead.end_us );
+        r.ahead     &= tx.queued_us <= ahead.start_us;
+    }
+    std::sort( margins.begin(), margins.end() );
+    r.min_margin    = margins.empty() ? 0 : margins.front();
+    r.median_margin = margins.empty() ? 0 : margins[ margins.size() / 2 ];
+    return r;
+}
+
+// Send a few frames at each CPU scale and check the margins; flush() sends one frame and
+// returns the reference for it
+template <typename F>
+static void run( const char *name, uint8_t unit, uint16_t reset_us, F flush ) {
+    const size_t overwrites = fake.overwrites;
+    int          bad        = 0;
+    refill_t     r;
+
+    // No CPU time: a whole chunk of slack every time
+    fake.cpu_scale = 0;
+    for ( int frame = 0; frame < 2; frame++ ) {
+        const size_t               first = fake.tx.size();
+        const std::vector<uint8_t> ref   = flush();
+        bad += !ref_frame_matches( fake_wire( unit, first ), ref );
+        r = refill_margins( first );
+        HOST_CHECK( r.chunks >= 3 );
+        if ( !HOST_CHECK( r.ahead && r.underruns == 0 && r.max_hole == RESTART_US ) ) {
+            printf( "  %s: chunks not queued a full chunk ahead (min margin %lld us of %lld, hole %lld us)\n", name,
+                    ( long long )r.min_margin, ( long long )r.wire_us, ( long long )r.max_hole );
+        }
+        // Well below the reset: a tenth of it at most
+        HOST_CHECK( r.max_hole * 10 <= reset_us );
+    }
+
+    // Host CPU time x 20: the slack of each chunk
+    fake.cpu_scale = 20;
+    std::vector<int64_t> mins, medians;
+    size_t               underruns = 0;
+    int64_t              hole      = 0;
+    for ( int frame = 0; frame < 9; frame++ ) {
+        const size_t               first = fake.tx.size();
+        const std::vector<uint8_t> ref   = flush();
+        bad += !ref_frame_matches( fake_wire( unit, first ), ref );
+        r = refill_margins( first );
+        underruns += r.underruns;
+        hole       = std::max( hole, r.max_hole );
+        mins.push_back( r.min_margin );
+        medians.push_back( r.median_margin );
+    }
+    std::sort( mins.begin(), mins.end() );
+    std::sort( medians.begin(), medians.end() );
+    // Host times vary with the build (sanitizers cost the group encode 15x): printed, not checked
+    const int64_t refill_us = r.wire_us + RESTART_US - medians[ 4 ];
+    printf( "%-30s %3u chunks of %5lld us wire: refill %4lld us at 20x host time, min margin %5lld us "
+            "(%u underruns in 9 frames, widest hole %lld us of %u us reset), underrun from ~%.0fx host time\n",
+            name, ( unsigned )r.chunks, ( long long )r.wire_us, ( long long )refill_us,
+            ( long long )mins[ 4 ], ( unsigned )underruns, ( long long )hole, reset_us,
+            refill_us > 0 ? 20.0 * r.wire_us / refill_us : 0.0 );
+
+    // A CPU far too slow: every refill is late, the frame is still right
+    fake.cpu_scale = 100000;
+    const size_t               first = fake.tx.size();
+    const std::vector<uint8_t> ref   = flush();
+    bad += !ref_frame_matches( fake_wire( unit, first ), ref );
+    r = refill_margins( first );
+    HOST_CHECK( r.underruns > 0 && r.min_margin < 0 && r.max_hole > RESTART_US );
+    fake.cpu_scale = 0;
+
+    if ( !HOST_CHECK( bad == 0 ) ) {
+        printf( "  %s: %d frames differ from the reference\n", name, bad );
+    }
+    HOST_CHECK( fake.overwrites == overwrites );
+}
+
+typedef struct {
+    uint8_t type;
+    size_t  length;
+    bool    rgbw;
+    uint8_t width;
+} strip_case_t;
+
+static const strip_case_t strips[] = {
+    { LED_STRIP_WS2812, 1500, false, 8 },
+    { LED_STRIP_APA106, 1000, false, 8 },       // 4 samples per bit
+    { LED_STRIP_SK6812, 4000, true, 1 },
+    { LED_STRIP_WS2812, 10000, false, 8 },
+    { LED_STRIP_WS2812, 10000, false, 1 },
+};
+
+typedef struct {
+    uint8_t lanes;
+    size_t  length;
+} group_case_t;
+
+static const group_case_t groups[] = {
+    { 8, 1500 },
+    { 16, 600 },
+};
+
+int main() {
+    srand( 15 );
+    fake_reset();
+    fake.restart_us = RESTART_US;
+    const size_t allocs = fake.allocs;
+    char         name[ 64 ];
+
+    // The shortest latch time of any LED type: a hole in the data must stay well below it
+    uint16_t reset_us = UINT16_MAX;
+    for ( uint8_t t = 0; t < LED_STRIP_TYPE_MAX; t++ ) {
+        reset_us = std::min( reset_us, parlio_led_params[ t ].reset_us );
+    }
+
+    for ( const strip_case_t &c : strips ) {
+        led_strip_t        strip;
+        parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+        host_strip_setup( &strip, c.type, c.length, c.rgbw );
+        parlio_strip_init( &strip, &cfg );
+        cfg.data_width = c.width;
+        if ( !HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+            continue;
+        }
+        // Memory is two chunks, whatever the length
+        HOST_CHECK( cfg.stream_chunk != 0 && cfg.parlio_buf_bytes == 2 * cfg.stream_chunk );
+        snprintf( name, sizeof( name ), "strip type %u, %u LEDs, width %u", c.type, ( unsigned )c.length, c.width );
+        run( name, fake_unit_index( cfg.parlio_chan ), reset_us, [ & ] {
+            host_scribble( &strip, c.length / 4 );
+            parlio_strip_flush( &strip, &cfg );
+            return c.width == 1 ? ref_strip_packed( &strip ) : ref_strip_bytes( &strip );
+        } );
+        HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+    }
+
+    for ( const group_case_t &g : groups ) {
+        host_lane_t        lanes[ 16 ];
+        parlio_group_cfg_t cfg;
+        for ( uint8_t n = 0; n < g.lanes; n++ ) {
+            lanes[ n ] = { n, LED_STRIP_WS2812, g.length - n * 7, false };     // lanes of uneven length
+        }
+        if ( !HOST_CHECK( host_group_install( &cfg, lanes, g.lanes ) == ESP_OK ) ) {
+            continue;
+        }
+        HOST_CHECK( cfg.stream_chunk != 0 );
+        snprintf( name, sizeof( name ), "group %u x %u LEDs", g.lanes, ( unsigned )g.length );
+        run( name, fake_unit_index( cfg.parlio_chan ), reset_us, [ & ] {
+            for ( uint8_t n = 0; n < g.lanes; n++ ) {
+                host_scribble( &cfg.lanes[ n ].strip, g.length / 4 );
+            }
+            parlio_group_flush( &cfg );
+            return ref_group_or( &cfg );
+        } );
+        HOST_CHECK( parlio_group_free( &cfg ) == ESP_OK );
+    }
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_stream_refill" );
+}
+
+//  --- EOF --- //
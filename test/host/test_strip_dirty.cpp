@@ -0,0 +1,115 @@
+//
+/*
+    LiteLEDpio: dirty-range re-encoding
+
+    parlio_strip_flush() only re-encodes the pixel bytes changed since the last frame.
+    Every frame on the wire must still equal a full encode of the current pixels
+    (ref_strip_bytes() / ref_strip_packed()). The edits go through the pixel API the way
+    LiteLEDpio uses it: set_pixel, set_pixels, fill, clear and brightness changes, with
+    show() and with showAsync() (two frame buffers, each missing the other's changes).
+    Also prints the show() time of a 600-LED status panel with a few pixels changed.
+*/
+
+#include "host_test.h"
+#include "host_ref.h"
+#include "ll_parlio_core.h"
+
+static void edit( led_strip_t *strip, int frame ) {
+    switch ( rand() % 8 ) {
+        case 0:
+            led_strip_fill( strip, rgb_from_code( ( uint32_t )rand() & 0xFFFFFF ) );
+            break;
+        case 1:
+            led_strip_clear( strip, host_pixel_bytes( strip ) );
+            break;
+        case 2: {
+            rgb_t  run[ 8 ];
+            size_t start = ( size_t )rand() % ( strip->length - 8 );
+            for ( rgb_t &c : run ) {
+                c = rgb_from_code( ( uint32_t )rand() & 0xFFFFFF );
+            }
+            led_strip_set_pixels( strip, start, 8, run );
+            break;
+        }
+        case 3:
+            if ( frame % 4 == 0 ) {
+                led_strip_set_brightness( strip, ( uint8_t )rand() );
+            }
+            break;
+        case 4:
+            break;      // nothing changed: the frame is resent as is
+        default:
+            host_scribble( strip, 1 + rand() % 5 );
+            break;
+    }
+}
+
+int main() {
+    srand( 19 );
+    fake_reset();
+    const size_t allocs = fake.allocs;
+
+    for ( uint8_t width : { 8, 1 } ) {
+        for ( bool async : { false, true } ) {
+            led_strip_t        strip;
+            parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+            // 400 LEDs keep data_width 8 below the streaming threshold, which always re-encodes
+            host_strip_setup( &strip, LED_STRIP_WS2812, 400 );
+            HOST_CHECK( parlio_strip_init( &strip, &cfg ) == ESP_OK );
+            cfg.data_width = width;
+            if ( !HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+                continue;
+            }
+            HOST_CHECK( cfg.stream_chunk == 0 );
+            const uint8_t unit = fake_unit_index( cfg.parlio_chan );
+            int bad = 0;
+
+            for ( int frame = 0; frame < 300; frame++ ) {
+                edit( &strip, frame );
+                const size_t first = fake.tx.size();
+                HOST_CHECK( ( async ? parlio_strip_flush_async( &strip, &cfg )
+                                    : parlio_strip_flush( &strip, &cfg ) ) == ESP_OK );
+                HOST_CHECK( fake.tx.size() == first + 1 );
+                const std::vector<uint8_t> ref = ( width == 1 ) ? ref_strip_packed( &strip ) : ref_strip_bytes( &strip );
+                bad += !ref_frame_matches( fake_wire( unit, first ), ref );
+            }
+            if ( !HOST_CHECK( bad == 0 ) ) {
+                printf( "  data_width %u %s: %d frames differ from a full encode\n", width,
+                        async ? "showAsync" : "show", bad );
+            }
+            HOST_CHECK( parlio_strip_wait( &cfg, -1 ) == ESP_OK );
+
+            HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+        }
+    }
+
+    // Status panel: 600 LEDs (packed, so not streamed), a handful of adjacent pixels per frame
+    led_strip_t        strip;
+    parlio_strip_cfg_t cfg = parlio_strip_cfg_t();
+    host_strip_setup( &strip, LED_STRIP_WS2812, 600 );
+    parlio_strip_init( &strip, &cfg );
+    cfg.data_width = 1;
+    if ( HOST_CHECK( parlio_strip_install( &strip, &cfg ) == ESP_OK ) ) {
+        auto status = [ & ]( bool full ) {
+            size_t first = ( size_t )rand() % ( strip.length - 4 );
+            for ( size_t i = first; i < first + 4; i++ ) {
+                led_strip_set_pixel( &strip, i, rgb_from_code( ( uint32_t )rand() & 0xFFFFFF ) );
+            }
+            if ( full ) {
+                led_strip_mark_dirty( &strip, 0, host_pixel_bytes( &strip ) );
+            }
+            parlio_strip_flush( &strip, &cfg );
+        };
+        fake.keep_data = false;
+        double few = host_time_us( 5000, [ & ] { status( false ); } );
+        double all = host_time_us( 5000, [ & ] { status( true ); } );
+        fake.keep_data = true;
+        printf( "600 LEDs, 4 pixels changed: %.2f us per show(), %.2f us with a full re-encode\n", few, all );
+        HOST_CHECK( parlio_strip_free( &strip, &cfg ) == ESP_OK );
+    }
+
+    HOST_CHECK( fake.allocs == allocs );
+    return host_finish( "test_strip_dirty" );
+}
+
+//  --- EOF --- //